@@ -29,6 +29,8 @@
 G_BEGIN_DECLS
 
 GtkWidget *_gtk_clutter_actor_get_embed (GtkClutterActor *actor);
+void       _gtk_clutter_actor_invalidate_size (GtkClutterActor *actor);
+void       _gtk_clutter_actor_queue_resize (GtkClutterActor *actor);
 void       _gtk_clutter_actor_update    (GtkClutterActor *actor,
 					 gint             x,
 					 gint             y,
@@ -41,8 +41,10 @@
 
 #include "gtk-clutter-actor.h"
 #include "gtk-clutter-offscreen.h"
+#include "gtk-clutter-widget-content.h"
 
 #include <math.h>
+#include <string.h>
 
 #include <glib-object.h>
 
@@ -54,9 +56,6 @@
 #ifdef GDK_WINDOWING_X11
 #include <gdk/gdkx.h>
 #endif
-#ifdef CAIRO_HAS_XLIB_SURFACE
-#include <cairo/cairo-xlib.h>
-#endif
 
 #ifdef CLUTTER_WINDOWING_WIN32
 #include <clutter/win32/clutter-win32.h>
@@ -77,28 +76,85 @@ G_DEFINE_TYPE (GtkClutterActor, gtk_clutter_actor, CLUTTER_TYPE_ACTOR)
 #define DEBUG(x)
 #endif
 
+/* number of size requests we remember for each orientation */
+#define N_CACHED_SIZES  3
+
+typedef struct _SizeRequest
+{
+  /* -1 if the request was not for a specific size */
+  gint for_size;
+
+  gint min_size;
+  gint natural_size;
+} SizeRequest;
+
 struct _GtkClutterActorPrivate
 {
   GtkWidget *widget;
   GtkWidget *embed;
 
-#ifdef CLUTTER_WINDOWING_X11
-  Drawable pixmap;
-#endif
+  /* the contents of the offscreen window; owned by the actor */
+  ClutterContent *content;
+
+  /* damage received from GTK+ since the last frame, and the
+   * repaint function that hands it over to the content
+   */
+  cairo_region_t *damage;
+  guint flush_id;
+
+  /* the repaint function checking whether a suspended actor has
+   * become visible again
+   */
+  guint visibility_id;
+
+  /* the highest number of updates per second, or 0 for no limit, and
+   * the timeout holding the updates of the offscreen window until the
+   * next one is allowed
+   */
+  guint max_update_rate;
+  guint rate_limit_id;
+
+  /* results of the GTK+ size negotiation, valid until the widget
+   * queues a resize
+   */
+  SizeRequest width_requests[N_CACHED_SIZES];
+  SizeRequest height_requests[N_CACHED_SIZES];
+  guint n_width_requests;
+  guint n_height_requests;
+
+  /* the size last given to the widget, and when */
+  gint allocated_width;
+  gint allocated_height;
+  gint64 last_allocation_time;
+
+  /* the interval between two allocations of the widget while the size
+   * of the actor is being animated, in milliseconds, or 0 to wait for
+   * the end of the animation
+   */
+  guint resize_interval;
 
-  /* canvas instance used as a fallback; owned
-   * by the texture actor below
+  guint use_atlas : 1;
+  guint frozen : 1;
+  guint suspended : 1;
+
+  /* set when the widget has to be allocated again even if the size
+   * of the actor did not change
    */
-  ClutterContent *canvas;
+  guint needs_allocation : 1;
 
-  ClutterActor *texture;
+  guint scale_during_resize : 1;
 };
 
 enum
 {
   PROP_0,
 
-  PROP_CONTENTS
+  PROP_CONTENTS,
+  PROP_USE_ATLAS,
+  PROP_FROZEN,
+  PROP_MAX_UPDATE_RATE,
+  PROP_SCALE_DURING_RESIZE,
+  PROP_RESIZE_INTERVAL
 };
 
 /* we allow overriding the default platform-specific code with an
@@ -115,37 +171,6 @@ gtk_clutter_actor_use_image_surface (void)
   return g_strcmp0 (env, "image") == 0;
 }
 
-/* paints the GtkClutterActorPrivate:surface on the cairo_t provided by
- * a ClutterCanvas, if we use the fallback path. this implies a copy,
- * plus a copy when we move the contents of the surface we use in the
- * ClutterCanvas on to the GPU, but it's the most portable method we have
- * at our disposal to implement embedding GTK widgets into Clutter actors.
- */
-static gboolean
-gtk_clutter_actor_draw_canvas (ClutterCanvas   *canvas,
-                               cairo_t         *cr,
-                               int              width,
-                               int              height,
-                               GtkClutterActor *actor)
-{
-  GtkClutterActorPrivate *priv = actor->priv;
-  cairo_surface_t *surface =
-    _gtk_clutter_offscreen_get_surface (GTK_CLUTTER_OFFSCREEN (priv->widget));
-
-  /* clear the surface */
-  cairo_save (cr);
-  cairo_set_source_rgba (cr, 1.0, 1.0, 1.0, 1.0);
-  cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
-  cairo_paint (cr);
-  cairo_restore (cr);
-
-  cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
-  cairo_set_source_surface (cr, surface, 0.0, 0.0);
-  cairo_paint (cr);
-
-  return TRUE;
-}
-
 static void
 gtk_clutter_actor_dispose (GObject *object)
 {
@@ -157,10 +182,30 @@ gtk_clutter_actor_dispose (GObject *object)
       priv->widget = NULL;
     }
 
-  if (priv->texture != NULL)
+  if (priv->flush_id != 0)
+    {
+      clutter_threads_remove_repaint_func (priv->flush_id);
+      priv->flush_id = 0;
+    }
+
+  if (priv->visibility_id != 0)
+    {
+      clutter_threads_remove_repaint_func (priv->visibility_id);
+      priv->visibility_id = 0;
+    }
+
+  if (priv->rate_limit_id != 0)
+    {
+      g_source_remove (priv->rate_limit_id);
+      priv->rate_limit_id = 0;
+    }
+
+  g_clear_pointer (&priv->damage, cairo_region_destroy);
+
+  if (priv->content != NULL)
     {
-      clutter_actor_destroy (priv->texture);
-      priv->texture = NULL;
+      clutter_actor_set_content (CLUTTER_ACTOR (object), NULL);
+      priv->content = NULL;
     }
 
   G_OBJECT_CLASS (gtk_clutter_actor_parent_class)->dispose (object);
@@ -172,53 +217,31 @@ gtk_clutter_actor_realize (ClutterActor *actor)
   GtkClutterActor *clutter = GTK_CLUTTER_ACTOR (actor);
   GtkClutterActorPrivate *priv = clutter->priv;
   ClutterActor *stage;
-  cairo_surface_t *surface;
 
   stage = clutter_actor_get_stage (actor);
   priv->embed = g_object_get_data (G_OBJECT (stage), "gtk-clutter-embed");
   gtk_container_add (GTK_CONTAINER (priv->embed), priv->widget);
 
   gtk_widget_realize (priv->widget);
+  priv->needs_allocation = TRUE;
 
-  surface = _gtk_clutter_offscreen_get_surface (GTK_CLUTTER_OFFSCREEN (priv->widget));
-
-#if defined(CLUTTER_WINDOWING_X11) && defined(CAIRO_HAS_XLIB_SURFACE)
-  if (!gtk_clutter_actor_use_image_surface () &&
-      clutter_check_windowing_backend (CLUTTER_WINDOWING_X11) &&
-      cairo_surface_get_type (surface) == CAIRO_SURFACE_TYPE_XLIB)
-    {
-      gint pixmap_width, pixmap_height;
+  if (priv->suspended)
+    gdk_window_freeze_updates (gtk_widget_get_window (priv->widget));
 
-      pixmap_width = cairo_xlib_surface_get_width (surface);
-      pixmap_height = cairo_xlib_surface_get_height (surface);
-      priv->pixmap = cairo_xlib_surface_get_drawable (surface);
+  if (priv->rate_limit_id != 0)
+    gdk_window_freeze_updates (gtk_widget_get_window (priv->widget));
 
-      clutter_x11_texture_pixmap_set_pixmap (CLUTTER_X11_TEXTURE_PIXMAP (priv->texture), priv->pixmap);
-      clutter_actor_set_size (priv->texture, pixmap_width, pixmap_height);
-    }
-  else
-#endif
+  if (priv->frozen)
     {
-      GdkWindow *window = gtk_widget_get_window (priv->widget);
-      int width = gtk_widget_get_allocated_width (priv->widget);
-      int height = gtk_widget_get_allocated_height (priv->widget);
-
-      DEBUG (G_STRLOC ": Using image surface.\n");
-
-      clutter_actor_set_size (priv->texture, width, height);
-
-      clutter_canvas_set_scale_factor (CLUTTER_CANVAS (priv->canvas),
-                                       gdk_window_get_scale_factor (window));
-      /* clutter_canvas_set_size() will invalidate its contents only
-       * if the size differs, but we want to invalidate the contents
-       * in any case; we cannot call clutter_content_invalidate()
-       * unconditionally, though, because that may cause two
-       * invalidations in a row, so we check the size of the canvas
-       * first.
-       */
-      if (!clutter_canvas_set_size (CLUTTER_CANVAS (priv->canvas), width, height))
-        clutter_content_invalidate (priv->canvas);
+      /* nothing gets drawn until the actor is thawed */
+      gdk_window_freeze_updates (gtk_widget_get_window (priv->widget));
+      return;
     }
+
+  /* the texture is (re)created at the size of the offscreen window
+   * when needed, but we want to show the contents in any case
+   */
+  _gtk_clutter_widget_content_damage (GTK_CLUTTER_WIDGET_CONTENT (priv->content), NULL);
 }
 
 static void
@@ -235,6 +258,96 @@ gtk_clutter_actor_unrealize (ClutterActor *actor)
   priv->embed = NULL;
 }
 
+static gboolean
+gtk_clutter_actor_lookup_widget_size (GtkClutterActor *actor,
+                                      GtkOrientation   orientation,
+                                      gint             for_size,
+                                      gint            *min_size,
+                                      gint            *natural_size)
+{
+  GtkClutterActorPrivate *priv = actor->priv;
+  SizeRequest *requests;
+  guint i, n_requests;
+
+  if (orientation == GTK_ORIENTATION_HORIZONTAL)
+    {
+      requests = priv->width_requests;
+      n_requests = priv->n_width_requests;
+    }
+  else
+    {
+      requests = priv->height_requests;
+      n_requests = priv->n_height_requests;
+    }
+
+  for (i = 0; i < MIN (n_requests, N_CACHED_SIZES); i++)
+    {
+      if (requests[i].for_size == for_size)
+        {
+          *min_size = requests[i].min_size;
+          *natural_size = requests[i].natural_size;
+          return TRUE;
+        }
+    }
+
+  return FALSE;
+}
+
+/* asks GTK+ for the size of the offscreen widget in the given
+ * @orientation, unless we already know it
+ */
+static void
+gtk_clutter_actor_get_widget_size (GtkClutterActor *actor,
+                                   GtkOrientation   orientation,
+                                   gint             for_size,
+                                   gint            *min_size,
+                                   gint            *natural_size)
+{
+  GtkClutterActorPrivate *priv = actor->priv;
+  SizeRequest *request;
+  guint *n_requests;
+
+  if (gtk_clutter_actor_lookup_widget_size (actor, orientation, for_size,
+                                            min_size, natural_size))
+    return;
+
+  if (orientation == GTK_ORIENTATION_HORIZONTAL)
+    {
+      if (for_size >= 0)
+        gtk_widget_get_preferred_width_for_height (priv->widget, for_size,
+                                                   min_size, natural_size);
+      else
+        gtk_widget_get_preferred_width (priv->widget, min_size, natural_size);
+    }
+  else
+    {
+      if (for_size >= 0)
+        gtk_widget_get_preferred_height_for_width (priv->widget, for_size,
+                                                   min_size, natural_size);
+      else
+        gtk_widget_get_preferred_height (priv->widget, min_size, natural_size);
+    }
+
+  if (orientation == GTK_ORIENTATION_HORIZONTAL)
+    {
+      request = priv->width_requests;
+      n_requests = &priv->n_width_requests;
+    }
+  else
+    {
+      request = priv->height_requests;
+      n_requests = &priv->n_height_requests;
+    }
+
+  /* once the cache is full, we replace the oldest entry */
+  request += *n_requests % N_CACHED_SIZES;
+  request->for_size = for_size;
+  request->min_size = *min_size;
+  request->natural_size = *natural_size;
+
+  *n_requests += 1;
+}
+
 static void
 gtk_clutter_actor_get_preferred_width (ClutterActor *actor,
                                        gfloat        for_height,
@@ -242,25 +355,14 @@ gtk_clutter_actor_get_preferred_width (ClutterActor *actor,
                                        gfloat       *natural_width_p)
 {
   GtkClutterActor *clutter = GTK_CLUTTER_ACTOR (actor);
-  GtkClutterActorPrivate *priv = clutter->priv;
   gint min_width, natural_width;
 
   min_width = natural_width = 0;
 
-  if (for_height >= 0)
-    {
-      for_height = ceilf (for_height);
-      gtk_widget_get_preferred_width_for_height (priv->widget,
-                                                 for_height,
-                                                 &min_width,
-                                                 &natural_width);
-    }
-  else
-    {
-      gtk_widget_get_preferred_width (priv->widget,
-                                      &min_width,
-                                      &natural_width);
-    }
+  gtk_clutter_actor_get_widget_size (clutter, GTK_ORIENTATION_HORIZONTAL,
+                                     for_height >= 0 ? ceilf (for_height) : -1,
+                                     &min_width,
+                                     &natural_width);
 
   if (min_width_p)
     *min_width_p = min_width;
@@ -276,25 +378,14 @@ gtk_clutter_actor_get_preferred_height (ClutterActor *actor,
                                         gfloat       *natural_height_p)
 {
   GtkClutterActor *clutter = GTK_CLUTTER_ACTOR (actor);
-  GtkClutterActorPrivate *priv = clutter->priv;
   gint min_height, natural_height;
 
   min_height = natural_height = 0;
 
-  if (for_width >= 0)
-    {
-      for_width = ceilf (for_width);
-      gtk_widget_get_preferred_height_for_width (priv->widget,
-                                                 for_width,
-                                                 &min_height,
-                                                 &natural_height);
-    }
-  else
-    {
-      gtk_widget_get_preferred_height (priv->widget,
-                                       &min_height,
-                                       &natural_height);
-    }
+  gtk_clutter_actor_get_widget_size (clutter, GTK_ORIENTATION_VERTICAL,
+                                     for_width >= 0 ? ceilf (for_width) : -1,
+                                     &min_height,
+                                     &natural_height);
 
   if (min_height_p)
     *min_height_p = min_height;
@@ -304,23 +395,21 @@ gtk_clutter_actor_get_preferred_height (ClutterActor *actor,
 }
 
 static void
-gtk_clutter_actor_allocate (ClutterActor           *actor,
-                            const ClutterActorBox  *box,
-                            ClutterAllocationFlags  flags)
+gtk_clutter_actor_allocate_widget (GtkClutterActor *actor,
+                                   GtkAllocation   *allocation)
 {
-  GtkClutterActor *clutter = GTK_CLUTTER_ACTOR (actor);
-  GtkClutterActorPrivate *priv = clutter->priv;
-  GtkAllocation child_allocation;
-  GdkWindow *window;
-  ClutterActorBox child_box;
+  GtkClutterActorPrivate *priv = actor->priv;
   gint dummy;
 
-  _gtk_clutter_offscreen_set_in_allocation (GTK_CLUTTER_OFFSCREEN (priv->widget), TRUE);
+  /* a resize queued while allocating has to be honoured the next
+   * time around
+   */
+  priv->allocated_width = allocation->width;
+  priv->allocated_height = allocation->height;
+  priv->last_allocation_time = g_get_monotonic_time ();
+  priv->needs_allocation = FALSE;
 
-  child_allocation.x = 0;
-  child_allocation.y = 0;
-  child_allocation.width = clutter_actor_box_get_width (box);
-  child_allocation.height = clutter_actor_box_get_height (box);
+  _gtk_clutter_offscreen_set_in_allocation (GTK_CLUTTER_OFFSCREEN (priv->widget), TRUE);
 
   /* Silence the following GTK+ warning:
    *
@@ -330,74 +419,83 @@ gtk_clutter_actor_allocate (ClutterActor           *actor,
    */
   gtk_widget_get_preferred_width (priv->widget, &dummy, NULL);
 
-  gtk_widget_size_allocate (priv->widget, &child_allocation);
+  gtk_widget_size_allocate (priv->widget, allocation);
 
-  if (CLUTTER_ACTOR_IS_REALIZED (actor))
-    {
-      cairo_surface_t *surface;
+  /* We do not wait for GTK+ to paint the widget at its new size here:
+   * until the damage for the new surface arrives, the texture keeps the
+   * previous contents, scaled to the new allocation. Only then do we
+   * switch over to the new buffer, when the content is flushed, so
+   * that there is no flicker, and the layout does not depend on how
+   * long the widget takes to repaint itself.
+   */
 
-      /* The former size allocate may have queued an expose we then need to
-       * process immediately, since we will paint the pixmap when this
-       * returns (as size allocation is done from clutter_redraw which is
-       * called from gtk_clutter_embed_expose_event(). If we don't do this
-       * we may see an intermediate state of the pixmap, causing flicker
-       */
-      window = gtk_widget_get_window (priv->widget);
-      gdk_window_process_updates (window, TRUE);
-
-      surface = gdk_offscreen_window_get_surface (window);
-#if defined(CLUTTER_WINDOWING_X11) && defined(CAIRO_HAS_XLIB_SURFACE)
-      if (!gtk_clutter_actor_use_image_surface () &&
-          clutter_check_windowing_backend (CLUTTER_WINDOWING_X11) &&
-          cairo_surface_get_type (surface) == CAIRO_SURFACE_TYPE_XLIB)
-        {
-          Drawable pixmap = cairo_xlib_surface_get_drawable (surface);
-
-          if (pixmap != priv->pixmap)
-            {
-              priv->pixmap = pixmap;
-              clutter_x11_texture_pixmap_set_pixmap (CLUTTER_X11_TEXTURE_PIXMAP (priv->texture),
-                                                     priv->pixmap);
-            }
-        }
-      else
-#endif
-        {
-          DEBUG (G_STRLOC ": Using image surface.\n");
+  _gtk_clutter_offscreen_set_in_allocation (GTK_CLUTTER_OFFSCREEN (priv->widget), FALSE);
+}
 
-          clutter_canvas_set_scale_factor (CLUTTER_CANVAS (priv->canvas),
-                                           gdk_window_get_scale_factor (window));
-          clutter_canvas_set_size (CLUTTER_CANVAS (priv->canvas),
-                                   gtk_widget_get_allocated_width (priv->widget),
-                                   gtk_widget_get_allocated_height (priv->widget));
-        }
-    }
+static gboolean
+gtk_clutter_actor_is_resize_transition (const gchar *name)
+{
+  return g_strcmp0 (name, "size") == 0 ||
+         g_strcmp0 (name, "width") == 0 ||
+         g_strcmp0 (name, "height") == 0;
+}
 
-  _gtk_clutter_offscreen_set_in_allocation (GTK_CLUTTER_OFFSCREEN (priv->widget), FALSE);
+/* whether the allocation of the widget should be skipped because the
+ * size of the actor is being animated
+ */
+static gboolean
+gtk_clutter_actor_defer_allocation (GtkClutterActor *actor)
+{
+  GtkClutterActorPrivate *priv = actor->priv;
+  ClutterActor *self = CLUTTER_ACTOR (actor);
 
-  clutter_actor_set_allocation (actor, box, (flags | CLUTTER_DELEGATE_LAYOUT));
+  if (!priv->scale_during_resize)
+    return FALSE;
+
+  /* there is nothing to stretch yet */
+  if (priv->allocated_width <= 0 || priv->allocated_height <= 0)
+    return FALSE;
+
+  if (clutter_actor_get_transition (self, "size") == NULL &&
+      clutter_actor_get_transition (self, "width") == NULL &&
+      clutter_actor_get_transition (self, "height") == NULL)
+    return FALSE;
 
-  child_box.x1 = child_box.y1 = 0.f;
-  child_box.x2 = clutter_actor_box_get_width (box);
-  child_box.y2 = clutter_actor_box_get_height (box);
+  if (priv->resize_interval > 0 &&
+      g_get_monotonic_time () - priv->last_allocation_time >= priv->resize_interval * 1000)
+    return FALSE;
 
-  /* we force the allocation of the offscreen texture */
-  clutter_actor_allocate (priv->texture, &child_box, flags);
+  return TRUE;
 }
 
 static void
-gtk_clutter_actor_paint (ClutterActor *actor)
+gtk_clutter_actor_allocate (ClutterActor           *actor,
+                            const ClutterActorBox  *box,
+                            ClutterAllocationFlags  flags)
 {
-  GtkClutterActorPrivate *priv = GTK_CLUTTER_ACTOR (actor)->priv;
-  ClutterActorIter iter;
-  ClutterActor *child;
+  GtkClutterActor *clutter = GTK_CLUTTER_ACTOR (actor);
+  GtkClutterActorPrivate *priv = clutter->priv;
+  GtkAllocation child_allocation;
 
-  /* we always paint the texture below everything else */
-  clutter_actor_paint (priv->texture);
+  child_allocation.x = 0;
+  child_allocation.y = 0;
+  child_allocation.width = clutter_actor_box_get_width (box);
+  child_allocation.height = clutter_actor_box_get_height (box);
 
-  clutter_actor_iter_init (&iter, actor);
-  while (clutter_actor_iter_next (&iter, &child))
-    clutter_actor_paint (child);
+  /* moving the actor around does not concern GTK+ at all; while the
+   * size is animated, the content stretches the last contents of the
+   * widget over the allocation instead, until the transition stops
+   */
+  if ((priv->needs_allocation ||
+       child_allocation.width != priv->allocated_width ||
+       child_allocation.height != priv->allocated_height) &&
+      !gtk_clutter_actor_defer_allocation (clutter))
+    gtk_clutter_actor_allocate_widget (clutter, &child_allocation);
+
+  /* the content fills the allocation, and is always painted below
+   * the children of the actor
+   */
+  clutter_actor_set_allocation (actor, box, (flags | CLUTTER_DELEGATE_LAYOUT));
 }
 
 static void
@@ -456,6 +554,18 @@ on_reactive_change (GtkClutterActor *actor)
                                      is_reactive);
 }
 
+static void
+on_transition_stopped (GtkClutterActor *actor,
+                       const gchar     *name,
+                       gboolean         is_finished)
+{
+  GtkClutterActorPrivate *priv = actor->priv;
+
+  /* the widget gets its final size */
+  if (priv->scale_during_resize && gtk_clutter_actor_is_resize_transition (name))
+    clutter_actor_queue_relayout (CLUTTER_ACTOR (actor));
+}
+
 static void
 gtk_clutter_actor_set_property (GObject       *gobject,
                                 guint          prop_id,
@@ -470,6 +580,26 @@ gtk_clutter_actor_set_property (GObject       *gobject,
       gtk_clutter_actor_set_contents (actor, g_value_get_object (value));
       break;
 
+    case PROP_USE_ATLAS:
+      gtk_clutter_actor_set_use_atlas (actor, g_value_get_boolean (value));
+      break;
+
+    case PROP_FROZEN:
+      gtk_clutter_actor_set_frozen (actor, g_value_get_boolean (value));
+      break;
+
+    case PROP_MAX_UPDATE_RATE:
+      gtk_clutter_actor_set_max_update_rate (actor, g_value_get_uint (value));
+      break;
+
+    case PROP_SCALE_DURING_RESIZE:
+      gtk_clutter_actor_set_scale_during_resize (actor, g_value_get_boolean (value));
+      break;
+
+    case PROP_RESIZE_INTERVAL:
+      gtk_clutter_actor_set_resize_interval (actor, g_value_get_uint (value));
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
       break;
@@ -490,6 +620,26 @@ gtk_clutter_actor_get_property (GObject    *gobject,
       g_value_set_object (value, gtk_bin_get_child (GTK_BIN (priv->widget)));
       break;
 
+    case PROP_USE_ATLAS:
+      g_value_set_boolean (value, priv->use_atlas);
+      break;
+
+    case PROP_FROZEN:
+      g_value_set_boolean (value, priv->frozen);
+      break;
+
+    case PROP_MAX_UPDATE_RATE:
+      g_value_set_uint (value, priv->max_update_rate);
+      break;
+
+    case PROP_SCALE_DURING_RESIZE:
+      g_value_set_boolean (value, priv->scale_during_resize);
+      break;
+
+    case PROP_RESIZE_INTERVAL:
+      g_value_set_uint (value, priv->resize_interval);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
       break;
@@ -505,7 +655,6 @@ gtk_clutter_actor_class_init (GtkClutterActorClass *klass)
 
   g_type_class_add_private (klass, sizeof (GtkClutterActorPrivate));
 
-  actor_class->paint = gtk_clutter_actor_paint;
   actor_class->realize = gtk_clutter_actor_realize;
   actor_class->unrealize = gtk_clutter_actor_unrealize;
   actor_class->show = gtk_clutter_actor_show;
@@ -532,6 +681,98 @@ gtk_clutter_actor_class_init (GtkClutterActorClass *klass)
                                G_PARAM_CONSTRUCT |
                                G_PARAM_STATIC_STRINGS);
   g_object_class_install_property (gobject_class, PROP_CONTENTS, pspec);
+
+  /**
+   * GtkClutterActor:use-atlas:
+   *
+   * Whether the contents of a small #GtkClutterActor should be stored
+   * in a texture shared with other actors.
+   *
+   * See gtk_clutter_actor_set_use_atlas() for details.
+   *
+   * Since: 1.8
+   */
+  pspec = g_param_spec_boolean ("use-atlas",
+                                "Use Atlas",
+                                "Whether to store small contents in a shared texture",
+                                FALSE,
+                                G_PARAM_READWRITE |
+                                G_PARAM_STATIC_STRINGS);
+  g_object_class_install_property (gobject_class, PROP_USE_ATLAS, pspec);
+
+  /**
+   * GtkClutterActor:frozen:
+   *
+   * Whether the contents of the #GtkClutterActor are frozen.
+   *
+   * See gtk_clutter_actor_set_frozen() for details.
+   *
+   * Since: 1.8
+   */
+  pspec = g_param_spec_boolean ("frozen",
+                                "Frozen",
+                                "Whether the widget contents are frozen",
+                                FALSE,
+                                G_PARAM_READWRITE |
+                                G_PARAM_STATIC_STRINGS);
+  g_object_class_install_property (gobject_class, PROP_FROZEN, pspec);
+
+  /**
+   * GtkClutterActor:max-update-rate:
+   *
+   * The maximum number of times per second the contents of the
+   * #GtkClutterActor are updated, or 0 for no limit.
+   *
+   * See gtk_clutter_actor_set_max_update_rate() for details.
+   *
+   * Since: 1.8
+   */
+  pspec = g_param_spec_uint ("max-update-rate",
+                             "Maximum Update Rate",
+                             "The maximum number of updates per second",
+                             0, G_MAXUINT,
+                             0,
+                             G_PARAM_READWRITE |
+                             G_PARAM_STATIC_STRINGS);
+  g_object_class_install_property (gobject_class, PROP_MAX_UPDATE_RATE, pspec);
+
+  /**
+   * GtkClutterActor:scale-during-resize:
+   *
+   * Whether the contents of the #GtkClutterActor are scaled, instead
+   * of being laid out again, while its size is animated.
+   *
+   * See gtk_clutter_actor_set_scale_during_resize() for details.
+   *
+   * Since: 1.8
+   */
+  pspec = g_param_spec_boolean ("scale-during-resize",
+                                "Scale During Resize",
+                                "Whether to scale the contents while the size is animated",
+                                FALSE,
+                                G_PARAM_READWRITE |
+                                G_PARAM_STATIC_STRINGS);
+  g_object_class_install_property (gobject_class, PROP_SCALE_DURING_RESIZE, pspec);
+
+  /**
+   * GtkClutterActor:resize-interval:
+   *
+   * The interval, in milliseconds, between two layouts of the embedded
+   * widget while the size of the #GtkClutterActor is animated, or 0 to
+   * lay it out only at the end of the animation.
+   *
+   * See gtk_clutter_actor_set_resize_interval() for details.
+   *
+   * Since: 1.8
+   */
+  pspec = g_param_spec_uint ("resize-interval",
+                             "Resize Interval",
+                             "The interval between two layouts during an animated resize",
+                             0, G_MAXUINT,
+                             0,
+                             G_PARAM_READWRITE |
+                             G_PARAM_STATIC_STRINGS);
+  g_object_class_install_property (gobject_class, PROP_RESIZE_INTERVAL, pspec);
 }
 
 static void
@@ -539,10 +780,14 @@ gtk_clutter_actor_init (GtkClutterActor *self)
 {
   GtkClutterActorPrivate *priv;
   ClutterActor *actor;
+  gboolean use_pixmap = FALSE;
 
   self->priv = priv = GTK_CLUTTER_ACTOR_GET_PRIVATE (self);
   actor = CLUTTER_ACTOR (self);
 
+  priv->damage = cairo_region_create ();
+  priv->needs_allocation = TRUE;
+
   priv->widget = _gtk_clutter_offscreen_new (actor);
   gtk_widget_set_name (priv->widget, "Offscreen Container");
   g_object_ref_sink (priv->widget);
@@ -551,42 +796,22 @@ gtk_clutter_actor_init (GtkClutterActor *self)
   clutter_actor_set_reactive (actor, TRUE);
 
 #if defined(CLUTTER_WINDOWING_X11)
-  if (!gtk_clutter_actor_use_image_surface () &&
-      clutter_check_windowing_backend (CLUTTER_WINDOWING_X11))
-    {
-      /* FIXME: write a GtkClutterWidgetContent that uses CoglTexturePixmapX11
-       * and a cairo_surface_t internally
-       */
-      priv->texture = clutter_x11_texture_pixmap_new ();
-
-      G_GNUC_BEGIN_IGNORE_DEPRECATIONS
-      clutter_texture_set_sync_size (CLUTTER_TEXTURE (priv->texture), FALSE);
-      G_GNUC_END_IGNORE_DEPRECATIONS
-
-      clutter_actor_add_child (actor, priv->texture);
-      clutter_actor_set_name (priv->texture, "Onscreen Texture");
-      clutter_actor_show (priv->texture);
-    }
-  else
+  use_pixmap = !gtk_clutter_actor_use_image_surface () &&
+               clutter_check_windowing_backend (CLUTTER_WINDOWING_X11);
 #endif
+
+  if (!use_pixmap)
     {
       DEBUG (G_STRLOC ": Using image surface.\n");
-
-      priv->canvas = clutter_canvas_new ();
-      g_signal_connect (priv->canvas, "draw",
-                        G_CALLBACK (gtk_clutter_actor_draw_canvas),
-                        actor);
-
-      priv->texture = clutter_actor_new ();
-      clutter_actor_set_content (priv->texture, priv->canvas);
-      clutter_actor_add_child (actor, priv->texture);
-      clutter_actor_set_name (priv->texture, "Onscreen Texture");
-      clutter_actor_show (priv->texture);
-
-      g_object_unref (priv->canvas);
     }
 
+  priv->content = _gtk_clutter_widget_content_new (GTK_CLUTTER_OFFSCREEN (priv->widget),
+                                                   use_pixmap);
+  clutter_actor_set_content (actor, priv->content);
+  g_object_unref (priv->content);
+
   g_signal_connect (self, "notify::reactive", G_CALLBACK (on_reactive_change), NULL);
+  g_signal_connect (self, "transition-stopped", G_CALLBACK (on_transition_stopped), NULL);
 }
 
 GtkWidget *
@@ -595,41 +820,378 @@ _gtk_clutter_actor_get_embed (GtkClutterActor *actor)
   return actor->priv->embed;
 }
 
-void
-_gtk_clutter_actor_update (GtkClutterActor *actor,
-			   gint             x,
-			   gint             y,
-			   gint             width,
-			   gint             height)
+/* whether any part of @actor can be seen on the stage; this is only
+ * a conservative estimate, and it returns %TRUE when in doubt
+ */
+static gboolean
+gtk_clutter_actor_is_visible_on_stage (GtkClutterActor *actor)
 {
-  GtkClutterActorPrivate *priv = actor->priv;
+  ClutterActor *self = CLUTTER_ACTOR (actor);
+  ClutterActor *stage, *parent;
+  ClutterActorBox box, clip;
+  gfloat stage_width, stage_height;
 
-#if defined(CLUTTER_WINDOWING_X11)
-  if (!gtk_clutter_actor_use_image_surface () &&
-      clutter_check_windowing_backend (CLUTTER_WINDOWING_X11))
-    {
-      clutter_x11_texture_pixmap_update_area (CLUTTER_X11_TEXTURE_PIXMAP (priv->texture),
-					      x, y, width, height);
-    }
-  else
-#endif
+  if (!clutter_actor_is_mapped (self))
+    return FALSE;
+
+  if (clutter_actor_get_paint_opacity (self) == 0)
+    return FALSE;
+
+  if (!clutter_actor_get_paint_box (self, &box))
+    return TRUE;
+
+  stage = clutter_actor_get_stage (self);
+  clutter_actor_get_size (stage, &stage_width, &stage_height);
+
+  if (box.x2 <= 0 || box.y2 <= 0 ||
+      box.x1 >= stage_width || box.y1 >= stage_height)
+    return FALSE;
+
+  /* the paint box of a clipped actor is its clip, so an ancestor
+   * whose paint box does not touch ours is hiding us
+   */
+  for (parent = clutter_actor_get_parent (self);
+       parent != NULL && parent != stage;
+       parent = clutter_actor_get_parent (parent))
     {
-      clutter_content_invalidate (priv->canvas);
+      if (!clutter_actor_has_clip (parent) &&
+          !clutter_actor_get_clip_to_allocation (parent))
+        continue;
+
+      if (!clutter_actor_get_paint_box (parent, &clip))
+        continue;
+
+      if (box.x2 <= clip.x1 || box.y2 <= clip.y1 ||
+          box.x1 >= clip.x2 || box.y1 >= clip.y2)
+        return FALSE;
     }
 
-  clutter_actor_queue_redraw (CLUTTER_ACTOR (actor));
+  return TRUE;
 }
 
-/**
- * gtk_clutter_actor_new:
- *
- * Creates a new #GtkClutterActor.
- *
- * This widget can be used to embed a #GtkWidget into a Clutter scene,
- * by retrieving the internal #GtkBin container using
- * gtk_clutter_actor_get_widget() and adding the #GtkWidget to it.
- *
- * Return value: the newly created #GtkClutterActor
+static gboolean gtk_clutter_actor_flush_damage (gpointer user_data);
+static void gtk_clutter_actor_queue_flush (GtkClutterActor *actor);
+
+static gboolean
+gtk_clutter_actor_rate_limit_timeout (gpointer user_data)
+{
+  GtkClutterActor *actor = user_data;
+  GtkClutterActorPrivate *priv = actor->priv;
+
+  priv->rate_limit_id = 0;
+
+  /* GDK draws what was invalidated in the meantime, and damages the
+   * widget again; this only picks up what was already damaged
+   */
+  if (gtk_widget_get_realized (priv->widget))
+    gdk_window_thaw_updates (gtk_widget_get_window (priv->widget));
+
+  if (!priv->frozen && !priv->suspended &&
+      !cairo_region_is_empty (priv->damage))
+    gtk_clutter_actor_queue_flush (actor);
+
+  return G_SOURCE_REMOVE;
+}
+
+/* keeps GTK+ from drawing the widget until the next update allowed by
+ * the maximum update rate; drawing into a pixmap bound to the texture
+ * would otherwise show up on the stage right away
+ */
+static void
+gtk_clutter_actor_hold_updates (GtkClutterActor *actor)
+{
+  GtkClutterActorPrivate *priv = actor->priv;
+
+  if (priv->rate_limit_id != 0)
+    return;
+
+  priv->rate_limit_id =
+    clutter_threads_add_timeout (MAX (1000 / priv->max_update_rate, 1),
+                                 gtk_clutter_actor_rate_limit_timeout,
+                                 actor);
+
+  if (gtk_widget_get_realized (priv->widget))
+    gdk_window_freeze_updates (gtk_widget_get_window (priv->widget));
+}
+
+static void
+gtk_clutter_actor_release_updates (GtkClutterActor *actor)
+{
+  GtkClutterActorPrivate *priv = actor->priv;
+
+  if (priv->rate_limit_id == 0)
+    return;
+
+  g_source_remove (priv->rate_limit_id);
+  priv->rate_limit_id = 0;
+
+  if (gtk_widget_get_realized (priv->widget))
+    gdk_window_thaw_updates (gtk_widget_get_window (priv->widget));
+}
+
+static gboolean
+gtk_clutter_actor_check_visibility (gpointer user_data)
+{
+  GtkClutterActor *actor = user_data;
+  GtkClutterActorPrivate *priv = actor->priv;
+
+  if (!gtk_clutter_actor_is_visible_on_stage (actor))
+    return G_SOURCE_CONTINUE;
+
+  priv->visibility_id = 0;
+  priv->suspended = FALSE;
+
+  _gtk_clutter_widget_content_set_frozen (GTK_CLUTTER_WIDGET_CONTENT (priv->content),
+                                          priv->frozen);
+
+  /* GDK draws everything that was invalidated while the actor was
+   * hidden in one go, and we upload what we already had
+   */
+  if (gtk_widget_get_realized (priv->widget))
+    gdk_window_thaw_updates (gtk_widget_get_window (priv->widget));
+
+  if (!priv->frozen)
+    gtk_clutter_actor_flush_damage (actor);
+
+  return G_SOURCE_REMOVE;
+}
+
+/* stops drawing the widget and updating the texture until the actor
+ * can be seen again
+ */
+static void
+gtk_clutter_actor_suspend (GtkClutterActor *actor)
+{
+  GtkClutterActorPrivate *priv = actor->priv;
+
+  if (priv->suspended)
+    return;
+
+  priv->suspended = TRUE;
+
+  _gtk_clutter_widget_content_set_frozen (GTK_CLUTTER_WIDGET_CONTENT (priv->content),
+                                          TRUE);
+
+  if (gtk_widget_get_realized (priv->widget))
+    gdk_window_freeze_updates (gtk_widget_get_window (priv->widget));
+
+  /* moving the actor back into view queues a redraw of the stage, so
+   * we just need to check again before each frame
+   */
+  priv->visibility_id =
+    clutter_threads_add_repaint_func_full (CLUTTER_REPAINT_FLAGS_PRE_PAINT,
+                                           gtk_clutter_actor_check_visibility,
+                                           actor,
+                                           NULL);
+}
+
+/* hands the damage accumulated since the last frame over to the
+ * content; this is called once per frame, before the stage is painted
+ */
+static gboolean
+gtk_clutter_actor_flush_damage (gpointer user_data)
+{
+  GtkClutterActor *actor = user_data;
+  GtkClutterActorPrivate *priv = actor->priv;
+
+  priv->flush_id = 0;
+
+  /* a frozen actor keeps the damage until it is thawed */
+  if (priv->frozen || cairo_region_is_empty (priv->damage))
+    return G_SOURCE_REMOVE;
+
+  /* there is no point in updating an actor that cannot be seen; the
+   * damage is kept until it becomes visible again
+   */
+  if (!gtk_clutter_actor_is_visible_on_stage (actor))
+    {
+      gtk_clutter_actor_suspend (actor);
+      return G_SOURCE_REMOVE;
+    }
+
+  /* on X11 the texture follows the changes of the pixmap by itself,
+   * but the content still needs to know when the widget has been drawn
+   * after a resize, and to queue a redraw; we are running before the
+   * paint already, so the upload happens right away
+   */
+  _gtk_clutter_widget_content_damage (GTK_CLUTTER_WIDGET_CONTENT (priv->content),
+                                      priv->damage);
+  _gtk_clutter_widget_content_flush (GTK_CLUTTER_WIDGET_CONTENT (priv->content));
+
+  cairo_region_destroy (priv->damage);
+  priv->damage = cairo_region_create ();
+
+  if (priv->max_update_rate > 0)
+    gtk_clutter_actor_hold_updates (actor);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gtk_clutter_actor_queue_flush (GtkClutterActor *actor)
+{
+  GtkClutterActorPrivate *priv = actor->priv;
+
+  /* the damage is kept until the next update we are allowed to do */
+  if (priv->rate_limit_id != 0)
+    return;
+
+  /* widgets may be damaged many times between two frames; we collect
+   * all the damage, and update the texture only once, right before
+   * the stage is painted
+   */
+  if (priv->flush_id == 0)
+    {
+      priv->flush_id =
+        clutter_threads_add_repaint_func_full (CLUTTER_REPAINT_FLAGS_PRE_PAINT,
+                                               gtk_clutter_actor_flush_damage,
+                                               actor,
+                                               NULL);
+
+      clutter_actor_queue_redraw (CLUTTER_ACTOR (actor));
+    }
+}
+
+/*
+ * _gtk_clutter_actor_invalidate_size:
+ * @actor: a #GtkClutterActor
+ *
+ * Forgets the sizes requested by the embedded widget, and updates the
+ * request mode of @actor to match the one of the widget. This must be
+ * called whenever the widget may have changed size.
+ */
+void
+_gtk_clutter_actor_invalidate_size (GtkClutterActor *actor)
+{
+  GtkClutterActorPrivate *priv = actor->priv;
+  ClutterRequestMode request_mode;
+
+  priv->n_width_requests = 0;
+  priv->n_height_requests = 0;
+  priv->needs_allocation = TRUE;
+
+  if (gtk_widget_get_request_mode (priv->widget) == GTK_SIZE_REQUEST_WIDTH_FOR_HEIGHT)
+    request_mode = CLUTTER_REQUEST_WIDTH_FOR_HEIGHT;
+  else
+    request_mode = CLUTTER_REQUEST_HEIGHT_FOR_WIDTH;
+
+  clutter_actor_set_request_mode (CLUTTER_ACTOR (actor), request_mode);
+}
+
+/* the sizes Clutter needs to lay out the actor at its current size:
+ * the size in the request mode orientation, and the size in the other
+ * orientation for the current allocation
+ */
+static gboolean
+gtk_clutter_actor_get_layout_sizes (GtkClutterActor *actor,
+                                    gboolean         cached_only,
+                                    gint             sizes[4])
+{
+  GtkClutterActorPrivate *priv = actor->priv;
+  GtkOrientation first, second;
+  gint for_size;
+
+  if (clutter_actor_get_request_mode (CLUTTER_ACTOR (actor)) == CLUTTER_REQUEST_WIDTH_FOR_HEIGHT)
+    {
+      first = GTK_ORIENTATION_VERTICAL;
+      second = GTK_ORIENTATION_HORIZONTAL;
+      for_size = priv->allocated_height;
+    }
+  else
+    {
+      first = GTK_ORIENTATION_HORIZONTAL;
+      second = GTK_ORIENTATION_VERTICAL;
+      for_size = priv->allocated_width;
+    }
+
+  if (cached_only)
+    return gtk_clutter_actor_lookup_widget_size (actor, first, -1, &sizes[0], &sizes[1]) &&
+           gtk_clutter_actor_lookup_widget_size (actor, second, for_size, &sizes[2], &sizes[3]);
+
+  gtk_clutter_actor_get_widget_size (actor, first, -1, &sizes[0], &sizes[1]);
+  gtk_clutter_actor_get_widget_size (actor, second, for_size, &sizes[2], &sizes[3]);
+
+  return TRUE;
+}
+
+/*
+ * _gtk_clutter_actor_queue_resize:
+ * @actor: a #GtkClutterActor
+ *
+ * Handles a resize queued by the embedded widget: a relayout of @actor
+ * is only queued if the widget now wants a different size; otherwise
+ * the widget is simply allocated again at its current size.
+ */
+void
+_gtk_clutter_actor_queue_resize (GtkClutterActor *actor)
+{
+  GtkClutterActorPrivate *priv = actor->priv;
+  ClutterRequestMode request_mode;
+  gint old_sizes[4], new_sizes[4];
+  gboolean has_old_sizes;
+
+  request_mode = clutter_actor_get_request_mode (CLUTTER_ACTOR (actor));
+  has_old_sizes = priv->allocated_width > 0 &&
+                  priv->allocated_height > 0 &&
+                  gtk_clutter_actor_get_layout_sizes (actor, TRUE, old_sizes);
+
+  _gtk_clutter_actor_invalidate_size (actor);
+
+  /* the allocation of the actor takes care of it */
+  if (GTK_CLUTTER_OFFSCREEN (priv->widget)->in_allocation)
+    return;
+
+  if (has_old_sizes &&
+      request_mode == clutter_actor_get_request_mode (CLUTTER_ACTOR (actor)) &&
+      gtk_clutter_actor_get_layout_sizes (actor, FALSE, new_sizes) &&
+      memcmp (old_sizes, new_sizes, sizeof (old_sizes)) == 0)
+    {
+      GtkAllocation allocation = { 0, 0, priv->allocated_width, priv->allocated_height };
+
+      gtk_clutter_actor_allocate_widget (actor, &allocation);
+      return;
+    }
+
+  clutter_actor_queue_relayout (CLUTTER_ACTOR (actor));
+}
+
+void
+_gtk_clutter_actor_update (GtkClutterActor *actor,
+			   gint             x,
+			   gint             y,
+			   gint             width,
+			   gint             height)
+{
+  GtkClutterActorPrivate *priv = actor->priv;
+  cairo_rectangle_int_t area;
+
+  area.x = x;
+  area.y = y;
+  area.width = width;
+  area.height = height;
+
+  cairo_region_union_rectangle (priv->damage, &area);
+
+  /* a frozen actor keeps showing its current contents, and a suspended
+   * one cannot be seen; the damage is flushed when the actor is thawed
+   * or becomes visible again
+   */
+  if (priv->frozen || priv->suspended)
+    return;
+
+  gtk_clutter_actor_queue_flush (actor);
+}
+
+/**
+ * gtk_clutter_actor_new:
+ *
+ * Creates a new #GtkClutterActor.
+ *
+ * This widget can be used to embed a #GtkWidget into a Clutter scene,
+ * by retrieving the internal #GtkBin container using
+ * gtk_clutter_actor_get_widget() and adding the #GtkWidget to it.
+ *
+ * Return value: the newly created #GtkClutterActor
  */
 ClutterActor *
 gtk_clutter_actor_new (void)
@@ -706,3 +1268,336 @@ gtk_clutter_actor_get_contents (GtkClutterActor *actor)
 
   return gtk_bin_get_child (GTK_BIN (actor->priv->widget));
 }
+
+/**
+ * gtk_clutter_actor_set_use_atlas:
+ * @actor: a #GtkClutterActor
+ * @use_atlas: whether to use the texture atlas
+ *
+ * Sets whether the contents of @actor should be stored in a texture
+ * atlas shared with other actors, when they are small enough.
+ *
+ * Actors sharing the same atlas can be painted without switching
+ * textures, which allows Clutter to batch their drawing; this is
+ * useful for stages showing a large number of small widgets, like
+ * buttons or labels. On X11, the contents of an actor using the atlas
+ * are copied instead of being bound directly to the texture.
+ *
+ * Since: 1.8
+ */
+void
+gtk_clutter_actor_set_use_atlas (GtkClutterActor *actor,
+                                 gboolean         use_atlas)
+{
+  GtkClutterActorPrivate *priv;
+
+  g_return_if_fail (GTK_CLUTTER_IS_ACTOR (actor));
+
+  priv = actor->priv;
+
+  use_atlas = !!use_atlas;
+  if (priv->use_atlas == use_atlas)
+    return;
+
+  priv->use_atlas = use_atlas;
+  _gtk_clutter_widget_content_set_use_atlas (GTK_CLUTTER_WIDGET_CONTENT (priv->content),
+                                             use_atlas);
+
+  g_object_notify (G_OBJECT (actor), "use-atlas");
+}
+
+/**
+ * gtk_clutter_actor_get_use_atlas:
+ * @actor: a #GtkClutterActor
+ *
+ * Retrieves whether @actor stores its contents in a shared texture
+ * atlas, see gtk_clutter_actor_set_use_atlas().
+ *
+ * Return value: %TRUE if the texture atlas is used
+ *
+ * Since: 1.8
+ */
+gboolean
+gtk_clutter_actor_get_use_atlas (GtkClutterActor *actor)
+{
+  g_return_val_if_fail (GTK_CLUTTER_IS_ACTOR (actor), FALSE);
+
+  return actor->priv->use_atlas;
+}
+
+/**
+ * gtk_clutter_actor_set_frozen:
+ * @actor: a #GtkClutterActor
+ * @frozen: whether the contents of @actor should be frozen
+ *
+ * Freezes or thaws the contents of @actor.
+ *
+ * While an actor is frozen the embedded widget is not redrawn, and the
+ * actor keeps painting the last contents it received, even if the
+ * widget changes state; this is useful to avoid spending time drawing
+ * the widget while @actor is being animated. When the actor is thawed,
+ * all the changes that happened in the meantime are drawn at once.
+ *
+ * An actor that is frozen before being realized paints nothing until
+ * it is thawed.
+ *
+ * Since: 1.8
+ */
+void
+gtk_clutter_actor_set_frozen (GtkClutterActor *actor,
+                              gboolean         frozen)
+{
+  GtkClutterActorPrivate *priv;
+
+  g_return_if_fail (GTK_CLUTTER_IS_ACTOR (actor));
+
+  priv = actor->priv;
+
+  frozen = !!frozen;
+  if (priv->frozen == frozen)
+    return;
+
+  priv->frozen = frozen;
+
+  _gtk_clutter_widget_content_set_frozen (GTK_CLUTTER_WIDGET_CONTENT (priv->content),
+                                          priv->frozen || priv->suspended);
+
+  /* GDK keeps track of what needs to be drawn again while the offscreen
+   * window is frozen, and draws it when it gets thawed
+   */
+  if (gtk_widget_get_realized (priv->widget))
+    {
+      GdkWindow *window = gtk_widget_get_window (priv->widget);
+
+      if (frozen)
+        gdk_window_freeze_updates (window);
+      else
+        gdk_window_thaw_updates (window);
+    }
+
+  if (frozen)
+    {
+      /* the pending update would show the current contents */
+      if (priv->flush_id != 0)
+        {
+          clutter_threads_remove_repaint_func (priv->flush_id);
+          priv->flush_id = 0;
+        }
+
+      gtk_clutter_actor_release_updates (actor);
+    }
+  else
+    {
+      cairo_rectangle_int_t area;
+
+      /* the actor may have been frozen before it got its contents for
+       * the first time, so the whole widget is updated
+       */
+      area.x = area.y = 0;
+      area.width = gtk_widget_get_allocated_width (priv->widget);
+      area.height = gtk_widget_get_allocated_height (priv->widget);
+      cairo_region_union_rectangle (priv->damage, &area);
+
+      if (!priv->suspended)
+        gtk_clutter_actor_queue_flush (actor);
+    }
+
+  g_object_notify (G_OBJECT (actor), "frozen");
+}
+
+/**
+ * gtk_clutter_actor_get_frozen:
+ * @actor: a #GtkClutterActor
+ *
+ * Retrieves whether the contents of @actor are frozen, see
+ * gtk_clutter_actor_set_frozen().
+ *
+ * Return value: %TRUE if the contents are frozen
+ *
+ * Since: 1.8
+ */
+gboolean
+gtk_clutter_actor_get_frozen (GtkClutterActor *actor)
+{
+  g_return_val_if_fail (GTK_CLUTTER_IS_ACTOR (actor), FALSE);
+
+  return actor->priv->frozen;
+}
+
+/**
+ * gtk_clutter_actor_set_max_update_rate:
+ * @actor: a #GtkClutterActor
+ * @rate: the maximum number of updates per second, or 0
+ *
+ * Sets the maximum number of times per second that the contents of
+ * @actor are updated on the stage.
+ *
+ * Changes of the embedded widget that happen faster than @rate are
+ * collected, and shown all at once at the next allowed update; the
+ * widget is not drawn at all in between. This is useful to limit the
+ * cost of widgets that change continuously, like a #GtkSpinner, when
+ * they are not the focus of the user.
+ *
+ * If @rate is 0, which is the default, the contents are updated at
+ * most once per frame.
+ *
+ * Since: 1.8
+ */
+void
+gtk_clutter_actor_set_max_update_rate (GtkClutterActor *actor,
+                                       guint            rate)
+{
+  GtkClutterActorPrivate *priv;
+
+  g_return_if_fail (GTK_CLUTTER_IS_ACTOR (actor));
+
+  priv = actor->priv;
+
+  if (priv->max_update_rate == rate)
+    return;
+
+  priv->max_update_rate = rate;
+
+  /* the pending update may now be allowed to happen sooner */
+  if (priv->rate_limit_id != 0)
+    {
+      gtk_clutter_actor_release_updates (actor);
+
+      if (!priv->frozen && !priv->suspended &&
+          !cairo_region_is_empty (priv->damage))
+        gtk_clutter_actor_queue_flush (actor);
+    }
+
+  g_object_notify (G_OBJECT (actor), "max-update-rate");
+}
+
+/**
+ * gtk_clutter_actor_get_max_update_rate:
+ * @actor: a #GtkClutterActor
+ *
+ * Retrieves the maximum number of updates per second of @actor, see
+ * gtk_clutter_actor_set_max_update_rate().
+ *
+ * Return value: the maximum update rate, or 0 if there is no limit
+ *
+ * Since: 1.8
+ */
+guint
+gtk_clutter_actor_get_max_update_rate (GtkClutterActor *actor)
+{
+  g_return_val_if_fail (GTK_CLUTTER_IS_ACTOR (actor), 0);
+
+  return actor->priv->max_update_rate;
+}
+
+/**
+ * gtk_clutter_actor_set_scale_during_resize:
+ * @actor: a #GtkClutterActor
+ * @scale: whether to scale the contents during animated resizes
+ *
+ * Sets whether the contents of @actor should be scaled while the size
+ * of @actor is animated, for instance using clutter_actor_set_size()
+ * with an easing duration.
+ *
+ * Laying out and drawing the embedded widget again at each frame of
+ * the animation can be expensive for complex widgets; if @scale is
+ * %TRUE, the last contents drawn by the widget are stretched over the
+ * actor instead, and the widget is only given its new size when the
+ * transition stops, or every #GtkClutterActor:resize-interval
+ * milliseconds.
+ *
+ * Since: 1.8
+ */
+void
+gtk_clutter_actor_set_scale_during_resize (GtkClutterActor *actor,
+                                           gboolean         scale)
+{
+  GtkClutterActorPrivate *priv;
+
+  g_return_if_fail (GTK_CLUTTER_IS_ACTOR (actor));
+
+  priv = actor->priv;
+
+  scale = !!scale;
+  if (priv->scale_during_resize == scale)
+    return;
+
+  priv->scale_during_resize = scale;
+
+  /* a resize in progress catches up right away */
+  if (!scale)
+    clutter_actor_queue_relayout (CLUTTER_ACTOR (actor));
+
+  g_object_notify (G_OBJECT (actor), "scale-during-resize");
+}
+
+/**
+ * gtk_clutter_actor_get_scale_during_resize:
+ * @actor: a #GtkClutterActor
+ *
+ * Retrieves whether the contents of @actor are scaled while its size
+ * is animated, see gtk_clutter_actor_set_scale_during_resize().
+ *
+ * Return value: %TRUE if the contents are scaled
+ *
+ * Since: 1.8
+ */
+gboolean
+gtk_clutter_actor_get_scale_during_resize (GtkClutterActor *actor)
+{
+  g_return_val_if_fail (GTK_CLUTTER_IS_ACTOR (actor), FALSE);
+
+  return actor->priv->scale_during_resize;
+}
+
+/**
+ * gtk_clutter_actor_set_resize_interval:
+ * @actor: a #GtkClutterActor
+ * @interval: the interval between two layouts, in milliseconds, or 0
+ *
+ * Sets how often the embedded widget is laid out at the current size
+ * of @actor while its size is animated, when the
+ * #GtkClutterActor:scale-during-resize property is set.
+ *
+ * If @interval is 0, which is the default, the widget is only laid out
+ * once the animation stops.
+ *
+ * Since: 1.8
+ */
+void
+gtk_clutter_actor_set_resize_interval (GtkClutterActor *actor,
+                                       guint            interval)
+{
+  GtkClutterActorPrivate *priv;
+
+  g_return_if_fail (GTK_CLUTTER_IS_ACTOR (actor));
+
+  priv = actor->priv;
+
+  if (priv->resize_interval == interval)
+    return;
+
+  priv->resize_interval = interval;
+
+  g_object_notify (G_OBJECT (actor), "resize-interval");
+}
+
+/**
+ * gtk_clutter_actor_get_resize_interval:
+ * @actor: a #GtkClutterActor
+ *
+ * Retrieves the interval between two layouts of the embedded widget
+ * while the size of @actor is animated, see
+ * gtk_clutter_actor_set_resize_interval().
+ *
+ * Return value: the interval in milliseconds, or 0
+ *
+ * Since: 1.8
+ */
+guint
+gtk_clutter_actor_get_resize_interval (GtkClutterActor *actor)
+{
+  g_return_val_if_fail (GTK_CLUTTER_IS_ACTOR (actor), 0);
+
+  return actor->priv->resize_interval;
+}
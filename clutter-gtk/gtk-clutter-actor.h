@@ -82,6 +82,22 @@ ClutterActor *gtk_clutter_actor_new_with_contents (GtkWidget       *contents);
 GtkWidget *   gtk_clutter_actor_get_contents      (GtkClutterActor *actor);
 GtkWidget *   gtk_clutter_actor_get_widget        (GtkClutterActor *actor);
 
+void          gtk_clutter_actor_set_use_atlas     (GtkClutterActor *actor,
+                                                   gboolean         use_atlas);
+gboolean      gtk_clutter_actor_get_use_atlas     (GtkClutterActor *actor);
+void          gtk_clutter_actor_set_frozen        (GtkClutterActor *actor,
+                                                   gboolean         frozen);
+gboolean      gtk_clutter_actor_get_frozen        (GtkClutterActor *actor);
+void          gtk_clutter_actor_set_max_update_rate (GtkClutterActor *actor,
+                                                     guint            rate);
+guint         gtk_clutter_actor_get_max_update_rate (GtkClutterActor *actor);
+void          gtk_clutter_actor_set_scale_during_resize (GtkClutterActor *actor,
+                                                         gboolean         scale);
+gboolean      gtk_clutter_actor_get_scale_during_resize (GtkClutterActor *actor);
+void          gtk_clutter_actor_set_resize_interval (GtkClutterActor *actor,
+                                                     guint            interval);
+guint         gtk_clutter_actor_get_resize_interval (GtkClutterActor *actor);
+
 G_END_DECLS
 
 #endif /* __GTK_CLUTTER_ACTOR_H__ */
@@ -67,6 +67,21 @@
  * on a #GtkClutterEmbed will trigger an assertion. It is strongly
  * advised not to override the #GtkContainer implementation when
  * subclassing #GtkClutterEmbed, to avoid breaking internal state.
+ *
+ * ## Using many GtkClutterEmbed widgets
+ *
+ * Each #GtkClutterEmbed has its own #ClutterStage, which is drawn in
+ * its own window, with its own GL surface; every stage is painted and
+ * presented separately, at the cost of a context switch and a buffer
+ * swap each.
+ *
+ * If a window shows many small scenes that are updated together, it
+ * is more efficient to use a single #GtkClutterEmbed, and to lay out
+ * each scene as an actor of its stage, for instance using a
+ * #ClutterGridLayout and clipping each scene with
+ * clutter_actor_set_clip_to_allocation(); GTK+ widgets can be placed
+ * between them with #GtkClutterActor. All the scenes are then painted
+ * in the same frame, and presented with a single swap.
  */
 
 #ifdef HAVE_CONFIG_H
@@ -78,6 +93,7 @@
 #include "gtk-clutter-embed.h"
 #include "gtk-clutter-offscreen.h"
 #include "gtk-clutter-actor.h"
+#include "gtk-clutter-stretch-effect.h"
 
 #include <glib-object.h>
 
@@ -111,6 +127,27 @@
 #include <gdk/gdkwayland.h>
 #endif
 
+/* changes of size less than this many milliseconds apart are part of
+ * the same interactive resize, which ends once the size has not changed
+ * for as long
+ */
+#define LIVE_RESIZE_TIMEOUT     150
+
+/* during an interactive resize, the stage is still laid out at its
+ * current size at least this often, in milliseconds
+ */
+#define LIVE_RESIZE_INTERVAL    250
+
+/* where each actor of the stage was last going to be painted */
+static GQuark paint_box_quark = 0;
+
+typedef struct _PausedTransition
+{
+  ClutterActor *actor;
+  gchar *name;
+  ClutterTransition *transition;
+} PausedTransition;
+
 struct _GtkClutterEmbedPrivate
 {
   ClutterActor *stage;
@@ -121,8 +158,65 @@ struct _GtkClutterEmbedPrivate
   guint queue_redraw_id;
   guint queue_relayout_id;
 
+  /* the frame clock of the toplevel, which tells us when the redraw
+   * we queued for the current frame has been done
+   */
+  GdkFrameClock *frame_clock;
+  guint frame_after_paint_id;
+
+  /* the areas of the stage invalidated since the last frame, unless
+   * the whole stage has been
+   */
+  cairo_region_t *redraw_region;
+
+  /* the effect stretching the stage over the window during a live
+   * resize, the timeout ending the resize, and the times of the last
+   * change of size and of the last layout of the stage
+   */
+  ClutterEffect *stretch_effect;
+  guint live_resize_id;
+  gint64 last_resize_time;
+  gint64 last_layout_time;
+
+  /* the size of the window Clutter and Cogl last heard about */
+  gint configured_width;
+  gint configured_height;
+
+  /* how long the stage stays realized after the embed is unmapped, and
+   * the timeout releasing it
+   */
+  guint keep_warm_timeout;
+  guint keep_warm_id;
+
+#if GLIB_CHECK_VERSION (2, 64, 0)
+  /* releases a stage kept warm when the system runs low on memory */
+  GMemoryMonitor *memory_monitor;
+  guint low_memory_id;
+#endif
+
+  /* the toplevel telling us whether the embed can be seen, and its
+   * signal handlers
+   */
+  GtkWidget *toplevel;
+  gulong window_state_id;
+  gulong visibility_id;
+
+  /* the transitions paused while the embed cannot be seen, and the
+   * actor of the stage that had the key focus when it was unmapped
+   */
+  GSList *paused_transitions;
+  ClutterActor *key_focus;
+
   guint geometry_changed : 1;
+  guint redraw_queued : 1;
+  guint stage_damaged : 1;
   guint use_layout_size : 1;
+  guint in_size_allocate : 1;
+  guint live_resize : 1;
+  guint toplevel_hidden : 1;
+  guint toplevel_obscured : 1;
+  guint suspended : 1;
+  guint pause_timelines : 1;
 
 #if defined(GDK_WINDOWING_WAYLAND) && defined(CLUTTER_WINDOWING_WAYLAND)
   struct wl_subcompositor *subcompositor;
@@ -137,7 +231,10 @@ enum
 {
   PROP_0,
 
-  PROP_USE_LAYOUT_SIZE
+  PROP_USE_LAYOUT_SIZE,
+  PROP_LIVE_RESIZE,
+  PROP_KEEP_WARM_TIMEOUT,
+  PROP_PAUSE_TIMELINES
 };
 
 G_DEFINE_TYPE_WITH_PRIVATE (GtkClutterEmbed, gtk_clutter_embed, GTK_TYPE_CONTAINER)
@@ -208,6 +305,61 @@ gtk_clutter_embed_ensure_subsurface (GtkClutterEmbed *embed)
 }
 #endif
 
+/* Clutter does not lay out, paint or swap a stage that is not mapped,
+ * and the master clock does not even wake up for its redraws. Hiding
+ * the stage would make Clutter withdraw the window GTK+ gave it, so
+ * a suspended stage is only unmapped
+ */
+static void
+gtk_clutter_embed_sync_stage_mapped (GtkClutterEmbed *embed)
+{
+  GtkClutterEmbedPrivate *priv = embed->priv;
+  ClutterStage *stage;
+
+  if (priv->stage == NULL)
+    return;
+
+  stage = CLUTTER_STAGE (priv->stage);
+
+  if (priv->suspended)
+    {
+      if (!clutter_actor_is_mapped (priv->stage))
+        return;
+
+      /* unmapping an actor takes the key focus away from it */
+      if (priv->key_focus == NULL &&
+          clutter_stage_get_key_focus (stage) != priv->stage)
+        {
+          priv->key_focus = clutter_stage_get_key_focus (stage);
+          g_object_add_weak_pointer (G_OBJECT (priv->key_focus),
+                                     (gpointer *) &priv->key_focus);
+        }
+
+      clutter_actor_unmap (priv->stage);
+    }
+  else
+    {
+      if (clutter_actor_is_mapped (priv->stage) ||
+          !clutter_actor_is_visible (priv->stage) ||
+          !clutter_actor_is_realized (priv->stage))
+        return;
+
+      clutter_actor_map (priv->stage);
+
+      if (priv->key_focus != NULL)
+        {
+          g_object_remove_weak_pointer (G_OBJECT (priv->key_focus),
+                                        (gpointer *) &priv->key_focus);
+
+          if (clutter_actor_get_stage (priv->key_focus) == priv->stage &&
+              clutter_stage_get_key_focus (stage) == priv->stage)
+            clutter_stage_set_key_focus (stage, priv->key_focus);
+
+          priv->key_focus = NULL;
+        }
+    }
+}
+
 static void
 gtk_clutter_embed_ensure_stage_realized (GtkClutterEmbed *embed)
 {
@@ -268,6 +420,9 @@ gtk_clutter_embed_ensure_stage_realized (GtkClutterEmbed *embed)
   if (gtk_widget_get_mapped (GTK_WIDGET (embed)))
     clutter_actor_show (priv->stage);
 
+  /* showing the stage maps it */
+  gtk_clutter_embed_sync_stage_mapped (embed);
+
   clutter_actor_queue_relayout (priv->stage);
 
   gtk_clutter_embed_send_configure (embed);
@@ -295,6 +450,317 @@ gtk_clutter_embed_stage_unrealize (GtkClutterEmbed *embed)
       clutter_actor_hide (priv->stage);
       clutter_actor_unrealize (priv->stage);
     }
+
+  /* a new stage window needs to be told its size */
+  priv->configured_width = 0;
+  priv->configured_height = 0;
+}
+
+static void
+gtk_clutter_embed_stop_keep_warm (GtkClutterEmbed *embed)
+{
+  GtkClutterEmbedPrivate *priv = embed->priv;
+
+  if (priv->keep_warm_id != 0)
+    {
+      g_source_remove (priv->keep_warm_id);
+      priv->keep_warm_id = 0;
+    }
+
+#if GLIB_CHECK_VERSION (2, 64, 0)
+  if (priv->memory_monitor != NULL)
+    {
+      g_signal_handler_disconnect (priv->memory_monitor, priv->low_memory_id);
+      priv->low_memory_id = 0;
+      g_clear_object (&priv->memory_monitor);
+    }
+#endif
+}
+
+static gboolean
+gtk_clutter_embed_release_stage (gpointer user_data)
+{
+  GtkClutterEmbed *embed = user_data;
+
+  embed->priv->keep_warm_id = 0;
+
+  gtk_clutter_embed_stop_keep_warm (embed);
+  gtk_clutter_embed_stage_unrealize (embed);
+
+  return G_SOURCE_REMOVE;
+}
+
+#if GLIB_CHECK_VERSION (2, 64, 0)
+static void
+on_low_memory_warning (GMemoryMonitor             *monitor,
+                       GMemoryMonitorWarningLevel  level,
+                       GtkClutterEmbed            *embed)
+{
+  gtk_clutter_embed_stop_keep_warm (embed);
+  gtk_clutter_embed_stage_unrealize (embed);
+}
+#endif
+
+/* keeps the stage, and the GL resources of its actors, around for a
+ * while after the embed has been unmapped, so that showing it again,
+ * e.g. when switching between the pages of a GtkNotebook, does not
+ * need to create them again
+ */
+static gboolean
+gtk_clutter_embed_keep_warm (GtkClutterEmbed *embed)
+{
+  GtkClutterEmbedPrivate *priv = embed->priv;
+
+  if (priv->keep_warm_timeout == 0 ||
+      priv->stage == NULL ||
+      !clutter_actor_is_realized (priv->stage))
+    return FALSE;
+
+#if defined(GDK_WINDOWING_WAYLAND) && defined(CLUTTER_WINDOWING_WAYLAND)
+  /* the subsurface would keep showing the last frame */
+  if (priv->subsurface != NULL)
+    return FALSE;
+#endif
+
+  clutter_actor_hide (priv->stage);
+
+  if (priv->keep_warm_id == 0)
+    priv->keep_warm_id =
+      gdk_threads_add_timeout (priv->keep_warm_timeout,
+                               gtk_clutter_embed_release_stage,
+                               embed);
+
+#if GLIB_CHECK_VERSION (2, 64, 0)
+  if (priv->memory_monitor == NULL)
+    {
+      priv->memory_monitor = g_memory_monitor_dup_default ();
+      priv->low_memory_id =
+        g_signal_connect (priv->memory_monitor,
+                          "low-memory-warning", G_CALLBACK (on_low_memory_warning),
+                          embed);
+    }
+#endif
+
+  return TRUE;
+}
+
+static void
+paused_transition_free (gpointer data)
+{
+  PausedTransition *paused = data;
+
+  g_object_unref (paused->actor);
+  g_object_unref (paused->transition);
+  g_free (paused->name);
+  g_slice_free (PausedTransition, paused);
+}
+
+static void
+gtk_clutter_embed_pause_transitions (GtkClutterEmbed *embed,
+                                     ClutterActor    *actor)
+{
+  GtkClutterEmbedPrivate *priv = embed->priv;
+  ClutterActorIter iter;
+  ClutterActor *child;
+  GParamSpec **pspecs;
+  guint i, n_pspecs;
+
+  /* the implicit transitions of an actor are named after the property
+   * they animate
+   */
+  pspecs = g_object_class_list_properties (G_OBJECT_GET_CLASS (actor), &n_pspecs);
+  for (i = 0; i < n_pspecs; i++)
+    {
+      ClutterTransition *transition;
+      PausedTransition *paused;
+
+      if ((pspecs[i]->flags & CLUTTER_PARAM_ANIMATABLE) == 0)
+        continue;
+
+      transition = clutter_actor_get_transition (actor, pspecs[i]->name);
+      if (transition == NULL ||
+          !clutter_timeline_is_playing (CLUTTER_TIMELINE (transition)))
+        continue;
+
+      clutter_timeline_pause (CLUTTER_TIMELINE (transition));
+
+      paused = g_slice_new (PausedTransition);
+      paused->actor = g_object_ref (actor);
+      paused->name = g_strdup (pspecs[i]->name);
+      paused->transition = g_object_ref (transition);
+
+      priv->paused_transitions = g_slist_prepend (priv->paused_transitions, paused);
+    }
+
+  g_free (pspecs);
+
+  clutter_actor_iter_init (&iter, actor);
+  while (clutter_actor_iter_next (&iter, &child))
+    gtk_clutter_embed_pause_transitions (embed, child);
+}
+
+static void
+gtk_clutter_embed_resume_transitions (GtkClutterEmbed *embed)
+{
+  GtkClutterEmbedPrivate *priv = embed->priv;
+  GSList *l;
+
+  for (l = priv->paused_transitions; l != NULL; l = l->next)
+    {
+      PausedTransition *paused = l->data;
+
+      /* the transition may have been removed, or replaced, meanwhile */
+      if (clutter_actor_get_transition (paused->actor, paused->name) == paused->transition &&
+          !clutter_timeline_is_playing (CLUTTER_TIMELINE (paused->transition)))
+        clutter_timeline_start (CLUTTER_TIMELINE (paused->transition));
+    }
+
+  g_slist_free_full (priv->paused_transitions, paused_transition_free);
+  priv->paused_transitions = NULL;
+}
+
+static void
+gtk_clutter_embed_update_suspended (GtkClutterEmbed *embed)
+{
+  GtkClutterEmbedPrivate *priv = embed->priv;
+  gboolean suspended;
+
+  if (priv->stage == NULL)
+    return;
+
+  suspended = !gtk_widget_get_mapped (GTK_WIDGET (embed)) ||
+              priv->toplevel_hidden ||
+              priv->toplevel_obscured;
+
+  /* the windowing system may have mapped the stage again meanwhile */
+  if (priv->suspended == suspended)
+    {
+      gtk_clutter_embed_sync_stage_mapped (embed);
+      return;
+    }
+
+  priv->suspended = suspended;
+
+  gtk_clutter_embed_sync_stage_mapped (embed);
+
+  if (suspended)
+    {
+      if (priv->pause_timelines)
+        gtk_clutter_embed_pause_transitions (embed, priv->stage);
+    }
+  else
+    {
+      gtk_clutter_embed_resume_transitions (embed);
+
+      /* whatever changed meanwhile has not been painted */
+      clutter_actor_queue_redraw (priv->stage);
+    }
+}
+
+static gboolean
+on_toplevel_window_state_event (GtkWidget           *toplevel,
+                                GdkEventWindowState *event,
+                                GtkClutterEmbed     *embed)
+{
+  GtkClutterEmbedPrivate *priv = embed->priv;
+
+  priv->toplevel_hidden =
+    (event->new_window_state & (GDK_WINDOW_STATE_ICONIFIED | GDK_WINDOW_STATE_WITHDRAWN)) != 0;
+
+  gtk_clutter_embed_update_suspended (embed);
+
+  return FALSE;
+}
+
+static gboolean
+on_toplevel_visibility_notify_event (GtkWidget          *toplevel,
+                                     GdkEventVisibility *event,
+                                     GtkClutterEmbed    *embed)
+{
+  GtkClutterEmbedPrivate *priv = embed->priv;
+
+  priv->toplevel_obscured = event->state == GDK_VISIBILITY_FULLY_OBSCURED;
+
+  gtk_clutter_embed_update_suspended (embed);
+
+  return FALSE;
+}
+
+static void
+gtk_clutter_embed_set_toplevel (GtkClutterEmbed *embed,
+                                GtkWidget       *toplevel)
+{
+  GtkClutterEmbedPrivate *priv = embed->priv;
+
+  if (priv->toplevel == toplevel)
+    return;
+
+  if (priv->toplevel != NULL)
+    {
+      g_signal_handler_disconnect (priv->toplevel, priv->window_state_id);
+      g_signal_handler_disconnect (priv->toplevel, priv->visibility_id);
+      priv->window_state_id = 0;
+      priv->visibility_id = 0;
+    }
+
+  priv->toplevel = toplevel;
+  priv->toplevel_hidden = FALSE;
+  priv->toplevel_obscured = FALSE;
+
+  if (toplevel != NULL)
+    {
+      GdkWindow *window = gtk_widget_get_window (toplevel);
+
+      if (window != NULL)
+        priv->toplevel_hidden =
+          (gdk_window_get_state (window) & (GDK_WINDOW_STATE_ICONIFIED | GDK_WINDOW_STATE_WITHDRAWN)) != 0;
+
+      priv->window_state_id =
+        g_signal_connect (toplevel,
+                          "window-state-event", G_CALLBACK (on_toplevel_window_state_event),
+                          embed);
+
+      /* only reported without a compositor; with one, the windows
+       * behind others may still be seen through them
+       */
+      gtk_widget_add_events (toplevel, GDK_VISIBILITY_NOTIFY_MASK);
+      priv->visibility_id =
+        g_signal_connect (toplevel,
+                          "visibility-notify-event", G_CALLBACK (on_toplevel_visibility_notify_event),
+                          embed);
+    }
+
+  gtk_clutter_embed_update_suspended (embed);
+}
+
+/* invalidates the area of the widget covered by @box, in stage
+ * coordinates
+ */
+static void
+gtk_clutter_embed_queue_draw_box (GtkClutterEmbed       *embed,
+                                  const ClutterActorBox *box)
+{
+  GtkClutterEmbedPrivate *priv = embed->priv;
+  cairo_rectangle_int_t area;
+
+  /* a busy stage queues redraws many times per frame, but GTK+ only
+   * needs to hear about the first one for each area
+   */
+  if (priv->redraw_queued)
+    return;
+
+  area.x = floorf (box->x1);
+  area.y = floorf (box->y1);
+  area.width = ceilf (box->x2) - area.x;
+  area.height = ceilf (box->y2) - area.y;
+
+  if (cairo_region_contains_rectangle (priv->redraw_region, &area) == CAIRO_REGION_OVERLAP_IN)
+    return;
+
+  cairo_region_union_rectangle (priv->redraw_region, &area);
+  gtk_widget_queue_draw_area (GTK_WIDGET (embed),
+                              area.x, area.y,
+                              area.width, area.height);
 }
 
 static void
@@ -304,13 +770,123 @@ on_stage_queue_redraw (ClutterStage *stage,
 {
   GtkWidget *embed = user_data;
   GtkClutterEmbedPrivate *priv = GTK_CLUTTER_EMBED (embed)->priv;
+  ClutterActorBox box, last_box;
+  gboolean has_box = FALSE, has_last_box = FALSE;
 
   if (priv->n_active_children > 0)
     priv->geometry_changed = TRUE;
 
+  priv->stage_damaged = TRUE;
+
+  /* the actor may have moved since it was last painted, and the area
+   * it leaves has to be drawn again as well; we remember where each
+   * actor was going to be painted the last time it queued a redraw,
+   * even when we do not need it for this one
+   */
+  if (origin != NULL &&
+      origin != CLUTTER_ACTOR (stage))
+    {
+      ClutterActorBox *stored_box;
+
+      stored_box = g_object_get_qdata (G_OBJECT (origin), paint_box_quark);
+      if (stored_box != NULL)
+        {
+          last_box = *stored_box;
+          has_last_box = TRUE;
+        }
+
+      has_box = clutter_actor_get_paint_box (origin, &box);
+      if (has_box)
+        g_object_set_qdata_full (G_OBJECT (origin), paint_box_quark,
+                                 clutter_actor_box_copy (&box),
+                                 (GDestroyNotify) clutter_actor_box_free);
+      else
+        g_object_set_qdata (G_OBJECT (origin), paint_box_quark, NULL);
+    }
+
+  /* the stage is redrawn as a whole once it can be seen again */
+  if (priv->suspended)
+    return;
+
+  /* while the stage is stretched, the clip Clutter computes for the
+   * redraw of an actor is in the coordinates of the stage, and does not
+   * cover the area where the actor is seen; the whole stage is redrawn
+   * instead, and that comes back here with the stage as the origin
+   */
+  if (priv->stretch_effect != NULL &&
+      origin != NULL &&
+      origin != CLUTTER_ACTOR (stage))
+    {
+      clutter_actor_queue_redraw (CLUTTER_ACTOR (stage));
+      return;
+    }
+
+  /* we do not know where an actor we never heard of was painted
+   * before, if at all
+   */
+  if (has_box && has_last_box)
+    {
+      gtk_clutter_embed_queue_draw_box (GTK_CLUTTER_EMBED (embed), &last_box);
+      gtk_clutter_embed_queue_draw_box (GTK_CLUTTER_EMBED (embed), &box);
+      return;
+    }
+
+  if (priv->redraw_queued)
+    return;
+
+  priv->redraw_queued = TRUE;
   gtk_widget_queue_draw (embed);
 }
 
+static void
+on_frame_clock_after_paint (GdkFrameClock   *frame_clock,
+                            GtkClutterEmbed *embed)
+{
+  GtkClutterEmbedPrivate *priv = embed->priv;
+
+  priv->redraw_queued = FALSE;
+
+  cairo_region_destroy (priv->redraw_region);
+  priv->redraw_region = cairo_region_create ();
+}
+
+/* asks the layout manager of the stage for its preferred size; GTK+
+ * remembers the answers until we queue a resize
+ */
+static void
+gtk_clutter_embed_get_layout_size (GtkClutterEmbed *embed,
+                                   GtkOrientation   orientation,
+                                   gint             for_size,
+                                   gint            *minimum,
+                                   gint            *natural)
+{
+  GtkClutterEmbedPrivate *priv = embed->priv;
+  float min, nat;
+
+  min = 0;
+  nat = 0;
+
+  if (priv->stage != NULL &&
+      priv->use_layout_size)
+    {
+      ClutterLayoutManager *manager = clutter_actor_get_layout_manager (priv->stage);
+      if (manager)
+        {
+          if (orientation == GTK_ORIENTATION_HORIZONTAL)
+            clutter_layout_manager_get_preferred_width (manager,
+                                                        CLUTTER_CONTAINER (priv->stage),
+                                                        (float)for_size, &min, &nat);
+          else
+            clutter_layout_manager_get_preferred_height (manager,
+                                                         CLUTTER_CONTAINER (priv->stage),
+                                                         (float)for_size, &min, &nat);
+        }
+    }
+
+  *minimum = ceilf (min);
+  *natural = ceilf (nat);
+}
+
 static void
 on_stage_queue_relayout (ClutterStage *stage,
 			 gpointer      user_data)
@@ -318,8 +894,21 @@ on_stage_queue_relayout (ClutterStage *stage,
   GtkWidget *embed = user_data;
   GtkClutterEmbedPrivate *priv = GTK_CLUTTER_EMBED (embed)->priv;
 
-  if (priv->use_layout_size)
-    gtk_widget_queue_resize (embed);
+  if (!priv->use_layout_size)
+    return;
+
+  /* resizing the stage from our own allocation queues a relayout, but
+   * that does not change the size of the layout
+   */
+  if (priv->in_size_allocate)
+    return;
+
+  /* any relayout may change the size of the layout for some of the
+   * sizes GTK+ asked about; queueing a resize drops the answers GTK+
+   * remembers, and many resizes queued in the same frame are handled
+   * in a single size negotiation
+   */
+  gtk_widget_queue_resize (embed);
 }
 
 static void
@@ -327,6 +916,11 @@ gtk_clutter_embed_dispose (GObject *gobject)
 {
   GtkClutterEmbedPrivate *priv = GTK_CLUTTER_EMBED (gobject)->priv;
 
+  gtk_clutter_embed_stop_keep_warm (GTK_CLUTTER_EMBED (gobject));
+  gtk_clutter_embed_set_toplevel (GTK_CLUTTER_EMBED (gobject), NULL);
+
+  g_slist_free_full (priv->paused_transitions, paused_transition_free);
+  priv->paused_transitions = NULL;
 
   if (priv->stage)
     {
@@ -339,6 +933,24 @@ gtk_clutter_embed_dispose (GObject *gobject)
       priv->queue_redraw_id = 0;
       priv->queue_relayout_id = 0;
 
+      if (priv->live_resize_id != 0)
+        {
+          g_source_remove (priv->live_resize_id);
+          priv->live_resize_id = 0;
+        }
+
+      /* the stage owns the effects */
+      priv->stretch_effect = NULL;
+
+      if (priv->key_focus != NULL)
+        {
+          g_object_remove_weak_pointer (G_OBJECT (priv->key_focus),
+                                        (gpointer *) &priv->key_focus);
+          priv->key_focus = NULL;
+        }
+
+      g_clear_pointer (&priv->redraw_region, cairo_region_destroy);
+
       clutter_actor_destroy (priv->stage);
       priv->stage = NULL;
 
@@ -414,14 +1026,41 @@ gtk_clutter_filter_func (GdkXEvent *native_event,
   return GDK_FILTER_CONTINUE;
 }
 
+#if defined(CLUTTER_WINDOWING_GDK)
+/* whether the last frame of the stage stays on screen until we paint a
+ * new one, even if GTK+ draws the window again
+ */
+static gboolean
+gtk_clutter_embed_retains_contents (GtkWidget *widget)
+{
+#if defined(GDK_WINDOWING_WAYLAND)
+  if (GDK_IS_WAYLAND_DISPLAY (gtk_widget_get_display (widget)))
+    return TRUE;
+#endif
+
+  return gdk_screen_is_composited (gtk_widget_get_screen (widget));
+}
+#endif
+
 static gboolean
 gtk_clutter_embed_draw (GtkWidget *widget, cairo_t *cr)
 {
 #if defined(CLUTTER_WINDOWING_GDK)
   GtkClutterEmbedPrivate *priv = GTK_CLUTTER_EMBED (widget)->priv;
 
-  if (clutter_check_windowing_backend (CLUTTER_WINDOWING_GDK))
-    clutter_stage_ensure_redraw (CLUTTER_STAGE (priv->stage));
+  /* GTK+ also draws the embed because of its siblings or of exposes;
+   * if nothing changed on the stage, and the compositor still has its
+   * last frame, there is no need to paint it again. A suspended stage
+   * keeps its damage until it can be seen
+   */
+  if (clutter_check_windowing_backend (CLUTTER_WINDOWING_GDK) &&
+      !priv->suspended)
+    {
+      if (priv->stage_damaged || !gtk_clutter_embed_retains_contents (widget))
+        clutter_stage_ensure_redraw (CLUTTER_STAGE (priv->stage));
+
+      priv->stage_damaged = FALSE;
+    }
 #endif
 
   return GTK_WIDGET_CLASS (gtk_clutter_embed_parent_class)->draw (widget, cr);
@@ -430,6 +1069,7 @@ gtk_clutter_embed_draw (GtkWidget *widget, cairo_t *cr)
 static void
 gtk_clutter_embed_realize (GtkWidget *widget)
 {
+  GtkClutterEmbedPrivate *priv = GTK_CLUTTER_EMBED (widget)->priv;
   GtkAllocation allocation;
   GtkStyleContext *style_context;
   GdkWindow *window;
@@ -539,6 +1179,18 @@ gtk_clutter_embed_realize (GtkWidget *widget)
       /* Nothing to do. */
     }
 
+  /* redraws are collected until the end of the next frame of the
+   * toplevel
+   */
+  priv->frame_clock = g_object_ref (gtk_widget_get_frame_clock (widget));
+  priv->frame_after_paint_id =
+    g_signal_connect (priv->frame_clock,
+                      "after-paint", G_CALLBACK (on_frame_clock_after_paint),
+                      widget);
+  priv->redraw_queued = FALSE;
+  cairo_region_destroy (priv->redraw_region);
+  priv->redraw_region = cairo_region_create ();
+
   gtk_clutter_embed_ensure_stage_realized (GTK_CLUTTER_EMBED (widget));
 }
 
@@ -546,6 +1198,28 @@ static void
 gtk_clutter_embed_unrealize (GtkWidget *widget)
 {
   GtkClutterEmbed *embed = GTK_CLUTTER_EMBED (widget);
+  GtkClutterEmbedPrivate *priv = embed->priv;
+
+  if (priv->live_resize_id != 0)
+    {
+      g_source_remove (priv->live_resize_id);
+      priv->live_resize_id = 0;
+    }
+
+  if (priv->stretch_effect != NULL)
+    {
+      clutter_actor_remove_effect (priv->stage, priv->stretch_effect);
+      priv->stretch_effect = NULL;
+    }
+
+  gtk_clutter_embed_stop_keep_warm (embed);
+
+  if (priv->frame_clock != NULL)
+    {
+      g_signal_handler_disconnect (priv->frame_clock, priv->frame_after_paint_id);
+      priv->frame_after_paint_id = 0;
+      g_clear_object (&priv->frame_clock);
+    }
 
   if (num_filter > 0)
     {
@@ -581,36 +1255,23 @@ gtk_clutter_embed_get_request_mode (GtkWidget *widget)
         case CLUTTER_REQUEST_CONTENT_SIZE:
           mode = GTK_SIZE_REQUEST_CONSTANT_SIZE;
           break;
-	}
-    }
-
-  return mode;
-}
-
-static void
-gtk_clutter_embed_get_preferred_width_for_height (GtkWidget *widget,
-						  gint       height,
-						  gint      *minimum,
-						  gint      *natural)
-{
-  GtkClutterEmbedPrivate *priv = GTK_CLUTTER_EMBED (widget)->priv;
-  float min, nat;
-
-  min = 0;
-  nat = 0;
-
-  if (priv->stage != NULL &&
-      priv->use_layout_size)
-    {
-      ClutterLayoutManager *manager = clutter_actor_get_layout_manager (priv->stage);
-      if (manager)
-	clutter_layout_manager_get_preferred_width (manager,
-						    CLUTTER_CONTAINER (priv->stage),
-						    (float)height, &min, &nat);
+	}
     }
 
-  min = ceilf (min);
-  nat = ceilf (nat);
+  return mode;
+}
+
+static void
+gtk_clutter_embed_get_preferred_width_for_height (GtkWidget *widget,
+						  gint       height,
+						  gint      *minimum,
+						  gint      *natural)
+{
+  gint min, nat;
+
+  gtk_clutter_embed_get_layout_size (GTK_CLUTTER_EMBED (widget),
+                                     GTK_ORIENTATION_HORIZONTAL, height,
+                                     &min, &nat);
 
   if (minimum)
     *minimum = min;
@@ -625,24 +1286,11 @@ gtk_clutter_embed_get_preferred_height_for_width (GtkWidget *widget,
 						  gint      *minimum,
 						  gint      *natural)
 {
-  GtkClutterEmbedPrivate *priv = GTK_CLUTTER_EMBED (widget)->priv;
-  float min, nat;
-
-  min = 0;
-  nat = 0;
+  gint min, nat;
 
-  if (priv->stage != NULL &&
-      priv->use_layout_size)
-    {
-      ClutterLayoutManager *manager = clutter_actor_get_layout_manager (priv->stage);
-      if (manager)
-	clutter_layout_manager_get_preferred_height (manager,
-						     CLUTTER_CONTAINER (priv->stage),
-						     (float)width, &min, &nat);
-    }
-
-  min = ceilf (min);
-  nat = ceilf (nat);
+  gtk_clutter_embed_get_layout_size (GTK_CLUTTER_EMBED (widget),
+                                     GTK_ORIENTATION_VERTICAL, width,
+                                     &min, &nat);
 
   if (minimum)
     *minimum = min;
@@ -667,46 +1315,118 @@ gtk_clutter_embed_get_preferred_height (GtkWidget *widget,
   gtk_clutter_embed_get_preferred_height_for_width (widget, -1, minimum, natural);
 }
 
+#if defined(GDK_WINDOWING_X11) && defined(CLUTTER_WINDOWING_X11)
+/* Cogl only learns about the new size of the window from the X server,
+ * after we draw the next frame, so we tell it right away
+ */
 static void
-gtk_clutter_embed_size_allocate (GtkWidget     *widget,
-                                 GtkAllocation *allocation)
+gtk_clutter_embed_send_x11_configure (GtkClutterEmbed *embed)
 {
-  GtkClutterEmbedPrivate *priv = GTK_CLUTTER_EMBED (widget)->priv;
+  GtkWidget *widget = GTK_WIDGET (embed);
   int scale_factor = gtk_widget_get_scale_factor (widget);
+  XConfigureEvent xevent = { ConfigureNotify };
 
-  gtk_widget_set_allocation (widget, allocation);
+  xevent.window = GDK_WINDOW_XID (gtk_widget_get_window (widget));
+  xevent.width = gtk_widget_get_allocated_width (widget) * scale_factor;
+  xevent.height = gtk_widget_get_allocated_height (widget) * scale_factor;
+
+  clutter_x11_handle_event ((XEvent *)&xevent);
+}
+#endif
+
+/* on X11 the stage is drawn and swapped by Clutter on its own, so after
+ * a resize GTK+ can complete the frame of the toplevel, and answer the
+ * _NET_WM_SYNC_REQUEST of the window manager, before the stage has been
+ * painted at the new size. GDK has no public API to hold the frame of
+ * a toplevel, so we cannot make GTK+ wait; instead, the stage is
+ * painted as soon as the master clock allows, without waiting for the
+ * sync delay, so that it follows the frame of GTK+ as closely as it can
+ */
+static void
+gtk_clutter_embed_sync_resize (GtkClutterEmbed *embed)
+{
+#if defined(GDK_WINDOWING_X11) && defined(CLUTTER_WINDOWING_X11)
+  GtkClutterEmbedPrivate *priv = embed->priv;
+  GtkWidget *widget = GTK_WIDGET (embed);
+
+  /* a suspended stage is not painted until it can be seen */
+  if (priv->suspended ||
+      !gtk_widget_get_realized (widget) ||
+      !clutter_actor_is_mapped (priv->stage) ||
+      !clutter_check_windowing_backend (CLUTTER_WINDOWING_X11) ||
+      !GDK_IS_X11_WINDOW (gtk_widget_get_window (widget)))
+    return;
+
+  clutter_stage_skip_sync_delay (CLUTTER_STAGE (priv->stage));
+  clutter_stage_ensure_redraw (CLUTTER_STAGE (priv->stage));
+#endif
+}
+
+/* resizes the stage to the allocation of @embed, laying it out again */
+static void
+gtk_clutter_embed_resize_stage (GtkClutterEmbed *embed)
+{
+  GtkClutterEmbedPrivate *priv = embed->priv;
+  GtkWidget *widget = GTK_WIDGET (embed);
+  GtkAllocation allocation;
+  gboolean was_stretched;
+
+  gtk_widget_get_allocation (widget, &allocation);
+
+  priv->last_layout_time = g_get_monotonic_time ();
+  was_stretched = priv->stretch_effect != NULL;
+
+  if (priv->live_resize_id != 0)
+    {
+      g_source_remove (priv->live_resize_id);
+      priv->live_resize_id = 0;
+    }
+
+  /* the viewport is set up again below */
+  if (priv->stretch_effect != NULL)
+    {
+      clutter_actor_remove_effect (priv->stage, priv->stretch_effect);
+      priv->stretch_effect = NULL;
+    }
 
   /* change the size of the stage and ensure that the viewport
    * has been updated as well
    */
-  clutter_actor_set_size (priv->stage, allocation->width, allocation->height);
+  priv->in_size_allocate = TRUE;
+  clutter_actor_set_size (priv->stage, allocation.width, allocation.height);
+  priv->in_size_allocate = FALSE;
 
   if (gtk_widget_get_realized (widget))
     {
       gdk_window_move_resize (gtk_widget_get_window (widget),
-                              allocation->x,
-                              allocation->y,
-                              allocation->width,
-                              allocation->height);
+                              allocation.x,
+                              allocation.y,
+                              allocation.width,
+                              allocation.height);
+
+      /* a new viewport makes Clutter repaint the whole stage, and on
+       * X11 a ConfigureNotify disables its clipped redraws for a while,
+       * so that the stage would otherwise never use partial swaps when
+       * GTK+ allocates the embed without changing its size
+       */
+      if (was_stretched ||
+          allocation.width != priv->configured_width ||
+          allocation.height != priv->configured_height)
+        {
+          priv->configured_width = allocation.width;
+          priv->configured_height = allocation.height;
 
-      clutter_stage_ensure_viewport (CLUTTER_STAGE (priv->stage));
+          clutter_stage_ensure_viewport (CLUTTER_STAGE (priv->stage));
 
-      gtk_clutter_embed_send_configure (GTK_CLUTTER_EMBED (widget));
+          gtk_clutter_embed_send_configure (embed);
 
 #if defined(GDK_WINDOWING_X11) && defined(CLUTTER_WINDOWING_X11)
-      if (clutter_check_windowing_backend (CLUTTER_WINDOWING_X11) &&
-	  GDK_IS_X11_WINDOW (gtk_widget_get_window (widget)))
-	{
-	  XConfigureEvent xevent = { ConfigureNotify };
-	  xevent.window = GDK_WINDOW_XID (gtk_widget_get_window (widget));
-	  xevent.width = allocation->width * scale_factor;
-	  xevent.height = allocation->height * scale_factor;
-
-	  /* Ensure cogl knows about the new size immediately, as we will
-	     draw before we get the ConfigureNotify response. */
-	  clutter_x11_handle_event ((XEvent *)&xevent);
-	}
+          if (clutter_check_windowing_backend (CLUTTER_WINDOWING_X11) &&
+              GDK_IS_X11_WINDOW (gtk_widget_get_window (widget)))
+            gtk_clutter_embed_send_x11_configure (embed);
 #endif
+        }
+
 #if defined(GDK_WINDOWING_WAYLAND) && defined(CLUTTER_WINDOWING_WAYLAND)
       if (priv->subsurface)
         {
@@ -718,6 +1438,112 @@ gtk_clutter_embed_size_allocate (GtkWidget     *widget,
     }
 }
 
+/* resizes the window of @embed without laying out the stage again; the
+ * stage keeps its size, and is stretched over the window until the
+ * resize is over. This is only possible where we can tell Cogl about
+ * the new size of the window ourselves
+ */
+static gboolean
+gtk_clutter_embed_stretch_stage (GtkClutterEmbed *embed)
+{
+#if defined(GDK_WINDOWING_X11) && defined(CLUTTER_WINDOWING_X11)
+  GtkClutterEmbedPrivate *priv = embed->priv;
+  GtkWidget *widget = GTK_WIDGET (embed);
+  GtkAllocation allocation;
+  int scale_factor;
+
+  if (!gtk_widget_get_realized (widget) ||
+      !clutter_actor_is_realized (priv->stage) ||
+      !clutter_check_windowing_backend (CLUTTER_WINDOWING_X11) ||
+      !GDK_IS_X11_WINDOW (gtk_widget_get_window (widget)))
+    return FALSE;
+
+  gtk_widget_get_allocation (widget, &allocation);
+  scale_factor = gtk_widget_get_scale_factor (widget);
+
+  gdk_window_move_resize (gtk_widget_get_window (widget),
+                          allocation.x,
+                          allocation.y,
+                          allocation.width,
+                          allocation.height);
+
+  gtk_clutter_embed_send_x11_configure (embed);
+  priv->configured_width = allocation.width;
+  priv->configured_height = allocation.height;
+
+  if (priv->stretch_effect == NULL)
+    {
+      priv->stretch_effect = _gtk_clutter_stretch_effect_new ();
+      clutter_actor_add_effect (priv->stage, priv->stretch_effect);
+    }
+
+  _gtk_clutter_stretch_effect_set_size (GTK_CLUTTER_STRETCH_EFFECT (priv->stretch_effect),
+                                        allocation.width * scale_factor,
+                                        allocation.height * scale_factor);
+
+  return TRUE;
+#else
+  return FALSE;
+#endif
+}
+
+static gboolean
+gtk_clutter_embed_end_live_resize (gpointer user_data)
+{
+  GtkClutterEmbed *embed = user_data;
+
+  embed->priv->live_resize_id = 0;
+
+  gtk_clutter_embed_resize_stage (embed);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gtk_clutter_embed_size_allocate (GtkWidget     *widget,
+                                 GtkAllocation *allocation)
+{
+  GtkClutterEmbed *embed = GTK_CLUTTER_EMBED (widget);
+  GtkClutterEmbedPrivate *priv = embed->priv;
+  GtkAllocation old_allocation;
+  gboolean resized;
+  gint64 now;
+
+  gtk_widget_get_allocation (widget, &old_allocation);
+  gtk_widget_set_allocation (widget, allocation);
+
+  resized = allocation->width != old_allocation.width ||
+            allocation->height != old_allocation.height;
+  now = g_get_monotonic_time ();
+
+  /* during an interactive resize, laying out a complex stage at every
+   * step is what makes the window lag behind the pointer; we stretch
+   * the last layout of the stage over the window instead, and lay it
+   * out at its final size once the resize is over
+   */
+  if (priv->live_resize && resized &&
+      now - priv->last_resize_time < LIVE_RESIZE_TIMEOUT * 1000 &&
+      now - priv->last_layout_time < LIVE_RESIZE_INTERVAL * 1000 &&
+      gtk_clutter_embed_stretch_stage (embed))
+    {
+      if (priv->live_resize_id != 0)
+        g_source_remove (priv->live_resize_id);
+
+      priv->live_resize_id =
+        gdk_threads_add_timeout (LIVE_RESIZE_TIMEOUT,
+                                 gtk_clutter_embed_end_live_resize,
+                                 embed);
+    }
+  else
+    gtk_clutter_embed_resize_stage (embed);
+
+  if (resized)
+    {
+      priv->last_resize_time = now;
+      gtk_clutter_embed_sync_resize (embed);
+    }
+}
+
 static gboolean
 gtk_clutter_embed_map_event (GtkWidget	 *widget,
                              GdkEventAny *event)
@@ -731,9 +1557,12 @@ gtk_clutter_embed_map_event (GtkWidget	 *widget,
   if (parent_class->map_event)
     res = parent_class->map_event (widget, event);
 
+  gtk_clutter_embed_stop_keep_warm (embed);
   gtk_clutter_embed_ensure_stage_realized (embed);
+  gtk_clutter_embed_update_suspended (embed);
 
-  clutter_actor_queue_redraw (priv->stage);
+  if (!priv->suspended)
+    clutter_actor_queue_redraw (priv->stage);
 
   return res;
 }
@@ -750,11 +1579,32 @@ gtk_clutter_embed_unmap_event (GtkWidget   *widget,
   if (parent_class->unmap_event)
     res = parent_class->unmap_event (widget, event);
 
-  gtk_clutter_embed_stage_unrealize (embed);
+  if (!gtk_clutter_embed_keep_warm (embed))
+    gtk_clutter_embed_stage_unrealize (embed);
+
+  gtk_clutter_embed_update_suspended (embed);
 
   return res;
 }
 
+static void
+gtk_clutter_embed_hierarchy_changed (GtkWidget *widget,
+                                     GtkWidget *old_toplevel)
+{
+  GtkWidgetClass *parent_class;
+  GtkWidget *toplevel;
+
+  parent_class = GTK_WIDGET_CLASS (gtk_clutter_embed_parent_class);
+  if (parent_class->hierarchy_changed)
+    parent_class->hierarchy_changed (widget, old_toplevel);
+
+  toplevel = gtk_widget_get_toplevel (widget);
+  if (!GTK_IS_WINDOW (toplevel))
+    toplevel = NULL;
+
+  gtk_clutter_embed_set_toplevel (GTK_CLUTTER_EMBED (widget), toplevel);
+}
+
 static gboolean
 gtk_clutter_embed_focus_in (GtkWidget     *widget,
                             GdkEventFocus *event)
@@ -1027,6 +1877,18 @@ gtk_clutter_embed_set_property (GObject       *gobject,
       gtk_clutter_embed_set_use_layout_size (embed, g_value_get_boolean (value));
       break;
 
+    case PROP_LIVE_RESIZE:
+      gtk_clutter_embed_set_live_resize (embed, g_value_get_boolean (value));
+      break;
+
+    case PROP_KEEP_WARM_TIMEOUT:
+      gtk_clutter_embed_set_keep_warm_timeout (embed, g_value_get_uint (value));
+      break;
+
+    case PROP_PAUSE_TIMELINES:
+      gtk_clutter_embed_set_pause_timelines (embed, g_value_get_boolean (value));
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
       break;
@@ -1047,6 +1909,18 @@ gtk_clutter_embed_get_property (GObject    *gobject,
       g_value_set_boolean (value, embed->priv->use_layout_size);
       break;
 
+    case PROP_LIVE_RESIZE:
+      g_value_set_boolean (value, embed->priv->live_resize);
+      break;
+
+    case PROP_KEEP_WARM_TIMEOUT:
+      g_value_set_uint (value, embed->priv->keep_warm_timeout);
+      break;
+
+    case PROP_PAUSE_TIMELINES:
+      g_value_set_boolean (value, embed->priv->pause_timelines);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
       break;
@@ -1061,6 +1935,8 @@ gtk_clutter_embed_class_init (GtkClutterEmbedClass *klass)
   GtkContainerClass *container_class = GTK_CONTAINER_CLASS (klass);
   GParamSpec *pspec;
 
+  paint_box_quark = g_quark_from_static_string ("gtk-clutter-embed-paint-box");
+
   gobject_class->dispose = gtk_clutter_embed_dispose;
   gobject_class->set_property = gtk_clutter_embed_set_property;
   gobject_class->get_property = gtk_clutter_embed_get_property;
@@ -1073,6 +1949,7 @@ gtk_clutter_embed_class_init (GtkClutterEmbedClass *klass)
   widget_class->show = gtk_clutter_embed_show;
   widget_class->map_event = gtk_clutter_embed_map_event;
   widget_class->unmap_event = gtk_clutter_embed_unmap_event;
+  widget_class->hierarchy_changed = gtk_clutter_embed_hierarchy_changed;
   widget_class->focus_in_event = gtk_clutter_embed_focus_in;
   widget_class->focus_out_event = gtk_clutter_embed_focus_out;
   widget_class->key_press_event = gtk_clutter_embed_key_event;
@@ -1103,6 +1980,58 @@ gtk_clutter_embed_class_init (GtkClutterEmbedClass *klass)
 				FALSE,
 				G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS);
   g_object_class_install_property (gobject_class, PROP_USE_LAYOUT_SIZE, pspec);
+
+  /**
+   * GtkClutterEmbed:live-resize:
+   *
+   * Whether the stage is stretched over the widget, instead of being
+   * laid out again, while the widget is being resized interactively.
+   *
+   * See gtk_clutter_embed_set_live_resize() for details.
+   *
+   * Since: 1.8
+   */
+  pspec = g_param_spec_boolean ("live-resize",
+                                "Live Resize",
+                                "Whether to stretch the stage during interactive resizes",
+                                FALSE,
+                                G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+  g_object_class_install_property (gobject_class, PROP_LIVE_RESIZE, pspec);
+
+  /**
+   * GtkClutterEmbed:keep-warm-timeout:
+   *
+   * How long, in milliseconds, the stage keeps its resources after the
+   * #GtkClutterEmbed has been unmapped, or 0 to release them right away.
+   *
+   * See gtk_clutter_embed_set_keep_warm_timeout() for details.
+   *
+   * Since: 1.8
+   */
+  pspec = g_param_spec_uint ("keep-warm-timeout",
+                             "Keep Warm Timeout",
+                             "How long the stage keeps its resources once unmapped",
+                             0, G_MAXUINT,
+                             0,
+                             G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+  g_object_class_install_property (gobject_class, PROP_KEEP_WARM_TIMEOUT, pspec);
+
+  /**
+   * GtkClutterEmbed:pause-timelines:
+   *
+   * Whether the transitions of the actors on the stage are paused while
+   * the #GtkClutterEmbed cannot be seen.
+   *
+   * See gtk_clutter_embed_set_pause_timelines() for details.
+   *
+   * Since: 1.8
+   */
+  pspec = g_param_spec_boolean ("pause-timelines",
+                                "Pause Timelines",
+                                "Whether to pause transitions while the widget cannot be seen",
+                                FALSE,
+                                G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+  g_object_class_install_property (gobject_class, PROP_PAUSE_TIMELINES, pspec);
 }
 
 #if defined(GDK_WINDOWING_WAYLAND) && defined(CLUTTER_WINDOWING_WAYLAND)
@@ -1147,6 +2076,8 @@ gtk_clutter_embed_init (GtkClutterEmbed *embed)
   embed->priv = priv = gtk_clutter_embed_get_instance_private (embed);
   widget = GTK_WIDGET (embed);
 
+  priv->redraw_region = cairo_region_create ();
+
   /* we have a real window backing our drawing */
   gtk_widget_set_has_window (widget, TRUE);
 
@@ -1298,3 +2229,204 @@ gtk_clutter_embed_get_honor_stage_size (GtkClutterEmbed *embed)
 
   return priv->use_layout_size;
 }
+
+/**
+ * gtk_clutter_embed_set_live_resize:
+ * @embed: a #GtkClutterEmbed
+ * @live_resize: whether to stretch the stage during interactive resizes
+ *
+ * Sets whether the stage of @embed should be stretched over the widget
+ * while it is being resized interactively, for instance when the user
+ * drags the border of the window.
+ *
+ * Laying out and painting a complex scene at every step of such a
+ * resize can make the window lag behind the pointer. If @live_resize
+ * is %TRUE, only the first change of size lays out the stage: the
+ * following ones stretch it over the widget, until the size has not
+ * changed for a short while, when the stage is laid out again at its
+ * final size. The stage is also laid out a few times per second while
+ * the resize goes on. While the stage is stretched, actors are picked
+ * where they are seen, but the coordinates of pointer events are the
+ * ones of the widget rather than the ones of the stretched stage.
+ *
+ * This is only supported on X11; on other windowing systems the stage
+ * is always laid out at the size of the widget.
+ *
+ * Since: 1.8
+ */
+void
+gtk_clutter_embed_set_live_resize (GtkClutterEmbed *embed,
+                                   gboolean         live_resize)
+{
+  GtkClutterEmbedPrivate *priv;
+
+  g_return_if_fail (GTK_CLUTTER_IS_EMBED (embed));
+
+  priv = embed->priv;
+
+  live_resize = !!live_resize;
+  if (priv->live_resize == live_resize)
+    return;
+
+  priv->live_resize = live_resize;
+
+  /* a resize in progress gets its layout right away */
+  if (!live_resize && priv->live_resize_id != 0)
+    gtk_clutter_embed_resize_stage (embed);
+
+  g_object_notify (G_OBJECT (embed), "live-resize");
+}
+
+/**
+ * gtk_clutter_embed_get_live_resize:
+ * @embed: a #GtkClutterEmbed
+ *
+ * Retrieves whether the stage of @embed is stretched during interactive
+ * resizes, see gtk_clutter_embed_set_live_resize().
+ *
+ * Return value: %TRUE if the stage is stretched during resizes
+ *
+ * Since: 1.8
+ */
+gboolean
+gtk_clutter_embed_get_live_resize (GtkClutterEmbed *embed)
+{
+  g_return_val_if_fail (GTK_CLUTTER_IS_EMBED (embed), FALSE);
+
+  return embed->priv->live_resize;
+}
+
+/**
+ * gtk_clutter_embed_set_keep_warm_timeout:
+ * @embed: a #GtkClutterEmbed
+ * @timeout: the time to keep the stage realized, in milliseconds, or 0
+ *
+ * Sets how long the stage of @embed stays realized after @embed has
+ * been unmapped.
+ *
+ * By default the stage is unrealized as soon as @embed is unmapped,
+ * which releases the GL resources of the stage and of its actors; they
+ * all have to be created again when @embed is mapped, which can take a
+ * noticeable time for complex scenes. With a non-zero @timeout, the
+ * stage is only hidden, and it is unrealized if @embed has not been
+ * mapped again after @timeout milliseconds, or when the system is low
+ * on memory. This is useful for widgets that are hidden and shown
+ * often, like the pages of a #GtkNotebook or of a #GtkStack.
+ *
+ * Since: 1.8
+ */
+void
+gtk_clutter_embed_set_keep_warm_timeout (GtkClutterEmbed *embed,
+                                         guint            timeout)
+{
+  GtkClutterEmbedPrivate *priv;
+
+  g_return_if_fail (GTK_CLUTTER_IS_EMBED (embed));
+
+  priv = embed->priv;
+
+  if (priv->keep_warm_timeout == timeout)
+    return;
+
+  priv->keep_warm_timeout = timeout;
+
+  /* a stage being kept warm follows the new timeout */
+  if (priv->keep_warm_id != 0)
+    {
+      gtk_clutter_embed_stop_keep_warm (embed);
+
+      if (!gtk_clutter_embed_keep_warm (embed))
+        gtk_clutter_embed_stage_unrealize (embed);
+    }
+
+  g_object_notify (G_OBJECT (embed), "keep-warm-timeout");
+}
+
+/**
+ * gtk_clutter_embed_get_keep_warm_timeout:
+ * @embed: a #GtkClutterEmbed
+ *
+ * Retrieves how long the stage of @embed stays realized after @embed
+ * has been unmapped, see gtk_clutter_embed_set_keep_warm_timeout().
+ *
+ * Return value: the timeout in milliseconds, or 0
+ *
+ * Since: 1.8
+ */
+guint
+gtk_clutter_embed_get_keep_warm_timeout (GtkClutterEmbed *embed)
+{
+  g_return_val_if_fail (GTK_CLUTTER_IS_EMBED (embed), 0);
+
+  return embed->priv->keep_warm_timeout;
+}
+
+/**
+ * gtk_clutter_embed_set_pause_timelines:
+ * @embed: a #GtkClutterEmbed
+ * @pause_timelines: whether to pause transitions while @embed cannot be seen
+ *
+ * Sets whether the transitions of the actors on the stage of @embed
+ * are paused while @embed cannot be seen.
+ *
+ * The stage of a #GtkClutterEmbed is not laid out nor painted while
+ * @embed is unmapped, while its toplevel is minimized, or while the
+ * toplevel is fully covered by other windows, when the windowing system
+ * reports it. The timelines driving the scene still advance, though,
+ * so that it is up to date when @embed can be seen again; they keep
+ * waking Clutter up at the frame rate, even though no frame is drawn.
+ *
+ * If @pause_timelines is %TRUE, the transitions of the animatable
+ * properties of the actors, like the ones created by the implicit
+ * animations, are paused instead, and resume where they were when
+ * @embed can be seen again. Timelines created by the application are
+ * not affected.
+ *
+ * Since: 1.8
+ */
+void
+gtk_clutter_embed_set_pause_timelines (GtkClutterEmbed *embed,
+                                       gboolean         pause_timelines)
+{
+  GtkClutterEmbedPrivate *priv;
+
+  g_return_if_fail (GTK_CLUTTER_IS_EMBED (embed));
+
+  priv = embed->priv;
+
+  pause_timelines = !!pause_timelines;
+  if (priv->pause_timelines == pause_timelines)
+    return;
+
+  priv->pause_timelines = pause_timelines;
+
+  if (priv->suspended && priv->stage != NULL)
+    {
+      if (pause_timelines)
+        gtk_clutter_embed_pause_transitions (embed, priv->stage);
+      else
+        gtk_clutter_embed_resume_transitions (embed);
+    }
+
+  g_object_notify (G_OBJECT (embed), "pause-timelines");
+}
+
+/**
+ * gtk_clutter_embed_get_pause_timelines:
+ * @embed: a #GtkClutterEmbed
+ *
+ * Retrieves whether the transitions of the actors on the stage of
+ * @embed are paused while @embed cannot be seen, see
+ * gtk_clutter_embed_set_pause_timelines().
+ *
+ * Return value: %TRUE if the transitions are paused
+ *
+ * Since: 1.8
+ */
+gboolean
+gtk_clutter_embed_get_pause_timelines (GtkClutterEmbed *embed)
+{
+  g_return_val_if_fail (GTK_CLUTTER_IS_EMBED (embed), FALSE);
+
+  return embed->priv->pause_timelines;
+}
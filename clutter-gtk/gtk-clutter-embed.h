@@ -88,6 +88,15 @@ ClutterActor *gtk_clutter_embed_get_stage (GtkClutterEmbed *embed);
 void          gtk_clutter_embed_set_use_layout_size (GtkClutterEmbed *embed,
 						     gboolean use_layout_size);
 gboolean      gtk_clutter_embed_get_use_layout_size (GtkClutterEmbed *embed);
+void          gtk_clutter_embed_set_live_resize     (GtkClutterEmbed *embed,
+                                                     gboolean         live_resize);
+gboolean      gtk_clutter_embed_get_live_resize     (GtkClutterEmbed *embed);
+void          gtk_clutter_embed_set_keep_warm_timeout (GtkClutterEmbed *embed,
+                                                       guint            timeout);
+guint         gtk_clutter_embed_get_keep_warm_timeout (GtkClutterEmbed *embed);
+void          gtk_clutter_embed_set_pause_timelines (GtkClutterEmbed *embed,
+                                                     gboolean         pause_timelines);
+gboolean      gtk_clutter_embed_get_pause_timelines (GtkClutterEmbed *embed);
 
 G_END_DECLS
 
@@ -4,18 +4,47 @@
 
 #include "config.h"
 
+#include <math.h>
+
 #include <gtk/gtk.h>
 
 #include "gtk-clutter-embed.h"
 #include "gtk-clutter-offscreen.h"
 #include "gtk-clutter-actor-internal.h"
 
+/* when the widget outgrows its window, the window is made larger than
+ * needed by this factor, so that the following steps of an interactive
+ * resize or of an animation do not need a new surface and texture each
+ */
+#define WINDOW_GROWTH_FACTOR    1.5
+
+/* how long the size of the widget has to stay the same before its
+ * window is shrunk back to it, in milliseconds
+ */
+#define WINDOW_SHRINK_TIMEOUT   1000
+
 G_DEFINE_TYPE (GtkClutterOffscreen, _gtk_clutter_offscreen, GTK_TYPE_BIN);
 
 void _gtk_clutter_embed_set_child_active (GtkClutterEmbed *embed,
 					  GtkWidget *child,
 					  gboolean active);
 
+/* forgets the sizes requested by the widget, queueing a relayout of
+ * the actor if they changed
+ */
+static void
+gtk_clutter_offscreen_invalidate_size (GtkClutterOffscreen *offscreen)
+{
+  if (offscreen->actor == NULL ||
+      gtk_widget_in_destruction (GTK_WIDGET (offscreen)))
+    return;
+
+  if (CLUTTER_ACTOR_IS_VISIBLE (offscreen->actor))
+    _gtk_clutter_actor_queue_resize (GTK_CLUTTER_ACTOR (offscreen->actor));
+  else
+    _gtk_clutter_actor_invalidate_size (GTK_CLUTTER_ACTOR (offscreen->actor));
+}
+
 static void
 gtk_clutter_offscreen_add (GtkContainer *container,
                            GtkWidget    *child)
@@ -24,12 +53,8 @@ gtk_clutter_offscreen_add (GtkContainer *container,
 
   GTK_CONTAINER_CLASS (_gtk_clutter_offscreen_parent_class)->add (container, child);
 
-  if (offscreen->actor != NULL &&
-      CLUTTER_ACTOR_IS_VISIBLE (offscreen->actor))
-    {
-      /* force a relayout */
-      clutter_actor_queue_relayout (offscreen->actor);
-    }
+  /* swapping the contents only needs a relayout if the size changes */
+  gtk_clutter_offscreen_invalidate_size (offscreen);
 }
 
 static void
@@ -40,12 +65,8 @@ gtk_clutter_offscreen_remove (GtkContainer *container,
 
   GTK_CONTAINER_CLASS (_gtk_clutter_offscreen_parent_class)->remove (container, child);
 
-  if (offscreen->actor != NULL &&
-      CLUTTER_ACTOR_IS_VISIBLE (offscreen->actor))
-    {
-      /* force a relayout */
-      clutter_actor_queue_relayout (offscreen->actor);
-    }
+  /* swapping the contents only needs a relayout if the size changes */
+  gtk_clutter_offscreen_invalidate_size (offscreen);
 }
 
 static void
@@ -53,11 +74,11 @@ gtk_clutter_offscreen_check_resize (GtkContainer *container)
 {
   GtkClutterOffscreen *offscreen = GTK_CLUTTER_OFFSCREEN (container);
 
-  /* queue a relayout only if we're not in the middle of an
-   * allocation
+  /* this queues a relayout only if the size of the widget changed,
+   * and if we're not in the middle of an allocation
    */
-  if (offscreen->actor != NULL && !offscreen->in_allocation)
-    clutter_actor_queue_relayout (offscreen->actor);
+  if (offscreen->actor != NULL)
+    _gtk_clutter_actor_queue_resize (GTK_CLUTTER_ACTOR (offscreen->actor));
 }
 
 static void
@@ -163,6 +184,9 @@ gtk_clutter_offscreen_realize (GtkWidget *widget)
   if (offscreen->active)
     _gtk_clutter_embed_set_child_active (GTK_CLUTTER_EMBED (parent),
 					 widget, TRUE);
+
+  /* the sizes we know were asked for before the widget got a screen */
+  gtk_clutter_offscreen_invalidate_size (offscreen);
 }
 
 static void
@@ -170,6 +194,12 @@ gtk_clutter_offscreen_unrealize (GtkWidget *widget)
 {
   GtkClutterOffscreen *offscreen = GTK_CLUTTER_OFFSCREEN (widget);
 
+  if (offscreen->shrink_id != 0)
+    {
+      g_source_remove (offscreen->shrink_id);
+      offscreen->shrink_id = 0;
+    }
+
   if (offscreen->active)
     _gtk_clutter_embed_set_child_active (GTK_CLUTTER_EMBED (gtk_widget_get_parent (widget)),
 					 widget, FALSE);
@@ -177,6 +207,43 @@ gtk_clutter_offscreen_unrealize (GtkWidget *widget)
   GTK_WIDGET_CLASS (_gtk_clutter_offscreen_parent_class)->unrealize (widget);
 }
 
+static void
+gtk_clutter_offscreen_parent_set (GtkWidget *widget,
+                                  GtkWidget *old_parent)
+{
+  GtkClutterOffscreen *offscreen = GTK_CLUTTER_OFFSCREEN (widget);
+
+  if (GTK_WIDGET_CLASS (_gtk_clutter_offscreen_parent_class)->parent_set)
+    GTK_WIDGET_CLASS (_gtk_clutter_offscreen_parent_class)->parent_set (widget, old_parent);
+
+  /* the widget inherits its style from the embed it is added to */
+  gtk_clutter_offscreen_invalidate_size (offscreen);
+}
+
+static void
+gtk_clutter_offscreen_style_updated (GtkWidget *widget)
+{
+  GtkClutterOffscreen *offscreen = GTK_CLUTTER_OFFSCREEN (widget);
+
+  GTK_WIDGET_CLASS (_gtk_clutter_offscreen_parent_class)->style_updated (widget);
+
+  /* fonts and paddings change the size of the widget, even when GTK+
+   * does not queue a resize for it
+   */
+  gtk_clutter_offscreen_invalidate_size (offscreen);
+}
+
+static GtkSizeRequestMode
+gtk_clutter_offscreen_get_request_mode (GtkWidget *widget)
+{
+  GtkWidget *child = gtk_bin_get_child (GTK_BIN (widget));
+
+  if (child != NULL && gtk_widget_get_visible (child))
+    return gtk_widget_get_request_mode (child);
+
+  return GTK_SIZE_REQUEST_CONSTANT_SIZE;
+}
+
 static void
 gtk_clutter_offscreen_get_preferred_width (GtkWidget *widget,
                                            gint      *minimum,
@@ -231,6 +298,121 @@ gtk_clutter_offscreen_get_preferred_height (GtkWidget *widget,
     }
 }
 
+static void
+gtk_clutter_offscreen_get_preferred_width_for_height (GtkWidget *widget,
+                                                      gint       for_height,
+                                                      gint      *minimum,
+                                                      gint      *natural)
+{
+  GtkBin *bin = GTK_BIN (widget);
+  GtkWidget *child;
+  gint border_width;
+
+  border_width = gtk_container_get_border_width (GTK_CONTAINER (widget));
+
+  *minimum = border_width * 2;
+  *natural = border_width * 2;
+
+  child = gtk_bin_get_child (bin);
+
+  if (child != NULL && gtk_widget_get_visible (child))
+    {
+      gint child_min, child_nat;
+
+      gtk_widget_get_preferred_width_for_height (child,
+                                                 MAX (for_height - border_width * 2, 0),
+                                                 &child_min, &child_nat);
+
+      *minimum += child_min;
+      *natural += child_nat;
+    }
+}
+
+static void
+gtk_clutter_offscreen_get_preferred_height_for_width (GtkWidget *widget,
+                                                      gint       for_width,
+                                                      gint      *minimum,
+                                                      gint      *natural)
+{
+  GtkBin *bin = GTK_BIN (widget);
+  GtkWidget *child;
+  gint border_width;
+
+  border_width = gtk_container_get_border_width (GTK_CONTAINER (widget));
+
+  *minimum = border_width * 2;
+  *natural = border_width * 2;
+
+  child = gtk_bin_get_child (bin);
+
+  if (child != NULL && gtk_widget_get_visible (child))
+    {
+      gint child_min, child_nat;
+
+      gtk_widget_get_preferred_height_for_width (child,
+                                                 MAX (for_width - border_width * 2, 0),
+                                                 &child_min, &child_nat);
+
+      *minimum += child_min;
+      *natural += child_nat;
+    }
+}
+
+static gboolean
+gtk_clutter_offscreen_shrink_window (gpointer user_data)
+{
+  GtkWidget *widget = user_data;
+
+  GTK_CLUTTER_OFFSCREEN (widget)->shrink_id = 0;
+
+  gdk_window_move_resize (gtk_widget_get_window (widget),
+                          0, 0,
+                          gtk_widget_get_allocated_width (widget),
+                          gtk_widget_get_allocated_height (widget));
+
+  return G_SOURCE_REMOVE;
+}
+
+/* the window, and with it the surface and the texture of the actor, is
+ * only replaced when the widget does not fit in it anymore; the part of
+ * the window outside of the allocation is not painted on the stage
+ */
+static void
+gtk_clutter_offscreen_resize_window (GtkClutterOffscreen *offscreen,
+                                     gint                 width,
+                                     gint                 height)
+{
+  GdkWindow *window = gtk_widget_get_window (GTK_WIDGET (offscreen));
+  gint window_width, window_height;
+
+  window_width = gdk_window_get_width (window);
+  window_height = gdk_window_get_height (window);
+
+  if (width > window_width || height > window_height)
+    {
+      if (width > window_width)
+        window_width = ceil (width * WINDOW_GROWTH_FACTOR);
+
+      if (height > window_height)
+        window_height = ceil (height * WINDOW_GROWTH_FACTOR);
+
+      gdk_window_move_resize (window, 0, 0, window_width, window_height);
+    }
+
+  /* the spare room is given back once the size settles */
+  if (offscreen->shrink_id != 0)
+    {
+      g_source_remove (offscreen->shrink_id);
+      offscreen->shrink_id = 0;
+    }
+
+  if (width != window_width || height != window_height)
+    offscreen->shrink_id =
+      clutter_threads_add_timeout (WINDOW_SHRINK_TIMEOUT,
+                                   gtk_clutter_offscreen_shrink_window,
+                                   offscreen);
+}
+
 static void
 gtk_clutter_offscreen_size_allocate (GtkWidget     *widget,
 				     GtkAllocation *allocation)
@@ -239,9 +421,15 @@ gtk_clutter_offscreen_size_allocate (GtkWidget     *widget,
   GtkBin *bin = GTK_BIN (widget);
   GtkWidget *child;
   gint border_width;
+  gboolean changed;
 
   gtk_widget_get_allocation (widget, &old_allocation);
 
+  changed = allocation->x != old_allocation.x ||
+            allocation->y != old_allocation.y ||
+            allocation->width != old_allocation.width ||
+            allocation->height != old_allocation.height;
+
   /* some widgets call gtk_widget_queue_resize() which triggers a
    * size request/allocate cycle.
    *
@@ -249,16 +437,11 @@ gtk_clutter_offscreen_size_allocate (GtkWidget     *widget,
    * widget tree, so we only want to do it if the allocation has changed in
    * some way, otherwise we can just ignore it.
    */
-  if (gtk_widget_get_realized (widget) &&
-      (allocation->x != old_allocation.x ||
-       allocation->y != old_allocation.y ||
-       allocation->width != old_allocation.width ||
-       allocation->height != old_allocation.height))
+  if (gtk_widget_get_realized (widget) && changed)
     {
-      gdk_window_move_resize (gtk_widget_get_window (widget),
-                              0, 0,
-                              allocation->width,
-                              allocation->height);
+      gtk_clutter_offscreen_resize_window (GTK_CLUTTER_OFFSCREEN (widget),
+                                           allocation->width,
+                                           allocation->height);
     }
 
   gtk_widget_set_allocation (widget, allocation);
@@ -279,7 +462,9 @@ gtk_clutter_offscreen_size_allocate (GtkWidget     *widget,
       gtk_widget_size_allocate (child, &child_alloc);
     }
 
-  gtk_widget_queue_draw (widget);
+  /* the child queues its own redraw if its allocation changes */
+  if (changed)
+    gtk_widget_queue_draw (widget);
 }
 
 static gboolean
@@ -305,8 +490,13 @@ _gtk_clutter_offscreen_class_init (GtkClutterOffscreenClass *klass)
 
   widget_class->realize = gtk_clutter_offscreen_realize;
   widget_class->unrealize = gtk_clutter_offscreen_unrealize;
+  widget_class->parent_set = gtk_clutter_offscreen_parent_set;
+  widget_class->style_updated = gtk_clutter_offscreen_style_updated;
+  widget_class->get_request_mode = gtk_clutter_offscreen_get_request_mode;
   widget_class->get_preferred_width = gtk_clutter_offscreen_get_preferred_width;
   widget_class->get_preferred_height = gtk_clutter_offscreen_get_preferred_height;
+  widget_class->get_preferred_width_for_height = gtk_clutter_offscreen_get_preferred_width_for_height;
+  widget_class->get_preferred_height_for_width = gtk_clutter_offscreen_get_preferred_height_for_width;
   widget_class->size_allocate = gtk_clutter_offscreen_size_allocate;
 
   container_class->add = gtk_clutter_offscreen_add;
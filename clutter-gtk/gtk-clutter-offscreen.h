@@ -23,6 +23,9 @@ struct _GtkClutterOffscreen
 
   ClutterActor *actor;
 
+  /* the timeout shrinking the window back to the size of the widget */
+  guint shrink_id;
+
   guint active : 1;
   guint in_allocation : 1;
 };
@@ -0,0 +1,146 @@
+/* gtk-clutter-stretch-effect.c: Stretches a stage over its window
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not see <http://www.fsf.org/licensing>.
+ */
+
+/*
+ * GtkClutterStretchEffect is used by GtkClutterEmbed while its window
+ * is being resized interactively: instead of laying out the stage again
+ * at every step, the stage keeps its size, and this effect makes it
+ * cover the whole window by replacing the viewport set up by Clutter
+ * with one of the size of the window.
+ *
+ * The stage is painted as usual, so the contents still update; only
+ * the layout lags behind until the resize settles. Picking does not go
+ * through pre_paint, so the same viewport is set up before picking, and
+ * actors are picked where they are seen. This has a few limits, which
+ * only last until the resize settles:
+ *
+ *  - the coordinates of events are the ones of the window, not the
+ *    ones of the stretched stage;
+ *  - Clutter does not pick outside of the size of the stage, so where
+ *    the window has grown past it, events go to the stage itself;
+ *  - the clip of a redraw is computed in the coordinates of the stage,
+ *    and does not cover the area where the actor is seen; the embed
+ *    queues a redraw of the whole stage instead of clipped ones while
+ *    this effect is applied.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gtk-clutter-stretch-effect.h"
+
+struct _GtkClutterStretchEffect
+{
+  ClutterEffect parent_instance;
+
+  /* size of the window, in pixels */
+  gint width;
+  gint height;
+};
+
+struct _GtkClutterStretchEffectClass
+{
+  ClutterEffectClass parent_class;
+};
+
+G_DEFINE_TYPE (GtkClutterStretchEffect,
+               _gtk_clutter_stretch_effect,
+               CLUTTER_TYPE_EFFECT)
+
+static void
+gtk_clutter_stretch_effect_set_viewport (GtkClutterStretchEffect *self)
+{
+  CoglFramebuffer *framebuffer;
+
+  if (self->width <= 0 || self->height <= 0)
+    return;
+
+  /* the stage sets up its viewport before being painted or picked, and
+   * only does it again once clutter_stage_ensure_viewport() has been
+   * called
+   */
+  framebuffer = cogl_get_draw_framebuffer ();
+  cogl_framebuffer_set_viewport (framebuffer,
+                                 0, 0,
+                                 self->width,
+                                 self->height);
+}
+
+static gboolean
+gtk_clutter_stretch_effect_pre_paint (ClutterEffect *effect)
+{
+  gtk_clutter_stretch_effect_set_viewport (GTK_CLUTTER_STRETCH_EFFECT (effect));
+
+  return TRUE;
+}
+
+static void
+gtk_clutter_stretch_effect_pick (ClutterEffect           *effect,
+                                 ClutterEffectPaintFlags  flags)
+{
+  /* the pixel under the pointer is read in window coordinates, so the
+   * stage is picked with the same viewport it is painted with
+   */
+  gtk_clutter_stretch_effect_set_viewport (GTK_CLUTTER_STRETCH_EFFECT (effect));
+
+  CLUTTER_EFFECT_CLASS (_gtk_clutter_stretch_effect_parent_class)->pick (effect, flags);
+}
+
+static void
+_gtk_clutter_stretch_effect_class_init (GtkClutterStretchEffectClass *klass)
+{
+  ClutterEffectClass *effect_class = CLUTTER_EFFECT_CLASS (klass);
+
+  effect_class->pre_paint = gtk_clutter_stretch_effect_pre_paint;
+  effect_class->pick = gtk_clutter_stretch_effect_pick;
+}
+
+static void
+_gtk_clutter_stretch_effect_init (GtkClutterStretchEffect *self)
+{
+}
+
+/*
+ * _gtk_clutter_stretch_effect_new:
+ *
+ * Creates a new #ClutterEffect stretching the stage it is applied to
+ * over the size set with _gtk_clutter_stretch_effect_set_size().
+ */
+ClutterEffect *
+_gtk_clutter_stretch_effect_new (void)
+{
+  return g_object_new (GTK_CLUTTER_TYPE_STRETCH_EFFECT, NULL);
+}
+
+/*
+ * _gtk_clutter_stretch_effect_set_size:
+ * @effect: a #GtkClutterStretchEffect
+ * @width: the width of the window, in pixels
+ * @height: the height of the window, in pixels
+ *
+ * Sets the size of the window the stage should cover.
+ */
+void
+_gtk_clutter_stretch_effect_set_size (GtkClutterStretchEffect *effect,
+                                      gint                     width,
+                                      gint                     height)
+{
+  effect->width = width;
+  effect->height = height;
+
+  clutter_effect_queue_repaint (CLUTTER_EFFECT (effect));
+}
@@ -0,0 +1,39 @@
+/* gtk-clutter-stretch-effect.h: Stretches a stage over its window
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not see <http://www.fsf.org/licensing>.
+ */
+
+#ifndef __GTK_CLUTTER_STRETCH_EFFECT_H__
+#define __GTK_CLUTTER_STRETCH_EFFECT_H__
+
+#include <clutter/clutter.h>
+
+G_BEGIN_DECLS
+
+#define GTK_CLUTTER_TYPE_STRETCH_EFFECT         (_gtk_clutter_stretch_effect_get_type ())
+#define GTK_CLUTTER_STRETCH_EFFECT(obj)         (G_TYPE_CHECK_INSTANCE_CAST ((obj), GTK_CLUTTER_TYPE_STRETCH_EFFECT, GtkClutterStretchEffect))
+#define GTK_CLUTTER_IS_STRETCH_EFFECT(obj)      (G_TYPE_CHECK_INSTANCE_TYPE ((obj), GTK_CLUTTER_TYPE_STRETCH_EFFECT))
+
+typedef struct _GtkClutterStretchEffect         GtkClutterStretchEffect;
+typedef struct _GtkClutterStretchEffectClass    GtkClutterStretchEffectClass;
+
+GType          _gtk_clutter_stretch_effect_get_type (void) G_GNUC_CONST;
+ClutterEffect *_gtk_clutter_stretch_effect_new      (void);
+void           _gtk_clutter_stretch_effect_set_size (GtkClutterStretchEffect *effect,
+                                                     gint                     width,
+                                                     gint                     height);
+
+G_END_DECLS
+
+#endif /* __GTK_CLUTTER_STRETCH_EFFECT_H__ */
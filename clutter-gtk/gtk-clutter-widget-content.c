@@ -0,0 +1,900 @@
+/* gtk-clutter-widget-content.c: ClutterContent for embedded widgets
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not see <http://www.fsf.org/licensing>.
+ */
+
+/*
+ * GtkClutterWidgetContent is the ClutterContent used by GtkClutterActor
+ * to paint the contents of its offscreen window.
+ *
+ * Unlike ClutterCanvas, which re-draws and re-uploads its whole buffer
+ * on every invalidation, this content keeps a single texture around and
+ * tracks the areas damaged by GTK+; only those areas are uploaded, and
+ * only when the content is about to be painted. Whenever possible, the
+ * pixels are uploaded straight from the GdkOffscreenWindow surface,
+ * without any intermediate buffer.
+ *
+ * On X11 the Xlib surface of the offscreen window is bound directly as
+ * a CoglTexturePixmapX11 instead: Cogl uses GLX_EXT_texture_from_pixmap
+ * when it is available, and tracks the changes to the pixmap through
+ * XDamage, so there is nothing left to upload.
+ *
+ * Small widgets can also be placed in the texture atlas shared by Cogl,
+ * so that a stage with many of them does not need a texture switch for
+ * each one: Cogl can batch the rectangles of textures living in the
+ * same atlas page.
+ *
+ * The resolution of the texture follows the size at which the actor is
+ * seen on the stage, in discrete steps: a widget shown as a thumbnail
+ * gets a smaller texture, and a zoomed in widget gets drawn again at a
+ * higher resolution than the one of its offscreen window.
+ *
+ * When the widget is resized, the previous texture is painted until
+ * GTK+ has drawn the widget at its new size; this way the layout of the
+ * actor does not have to wait for the widget to be repainted.
+ *
+ * The offscreen window may be larger than the widget, to avoid creating
+ * a new surface and texture for each step of a resize; only the part of
+ * the texture covered by the widget is uploaded and painted.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+/* CoglTexturePixmapX11 is only available as experimental API */
+#define COGL_ENABLE_EXPERIMENTAL_API
+
+#include "gtk-clutter-widget-content.h"
+
+#include <math.h>
+
+#include <gdk/gdk.h>
+
+#ifdef CAIRO_HAS_XLIB_SURFACE
+#include <cairo/cairo-xlib.h>
+#endif
+
+/* past this number of damaged rectangles it is cheaper to upload their
+ * bounding box in one go than to issue one upload for each of them
+ */
+#define MAX_DAMAGE_RECTS        8
+
+/* largest texture, in pixels, that we try to put in the atlas; larger
+ * textures would not leave much room for other widgets in a page
+ */
+#define ATLAS_MAX_SIZE          256
+
+/* the resolutions we allow for the texture, in pixels per widget unit;
+ * the scale is only changed once the actor is seen at a scale that is
+ * at least SCALE_HYSTERESIS away from the current step
+ */
+static const double scale_steps[] = { 0.25, 0.5, 1.0, 1.5, 2.0, 3.0, 4.0 };
+
+#define SCALE_HYSTERESIS        0.1
+
+struct _GtkClutterWidgetContent
+{
+  GObject parent_instance;
+
+  /* back pointer; the GtkClutterActor owns both the offscreen
+   * widget and this content
+   */
+  GtkClutterOffscreen *offscreen;
+
+  CoglTexture *texture;
+
+  /* whether we should try to bind the pixmap of the offscreen surface
+   * instead of uploading its contents
+   */
+  guint use_pixmap : 1;
+
+  /* whether small textures should be allocated in the shared atlas */
+  guint use_atlas : 1;
+
+  /* set when the texture has to be replaced even if the size of the
+   * offscreen window did not change
+   */
+  guint needs_new_texture : 1;
+
+  /* set while the actor is frozen or cannot be seen; the texture then
+   * keeps its resolution, since filling it again would draw the widget
+   */
+  guint frozen : 1;
+
+  /* the surface owning the pixmap bound to the texture, if any; we
+   * hold a reference on it so that the pixmap stays around until we
+   * stop using it
+   */
+  cairo_surface_t *surface;
+
+  /* size of the texture, in widget coordinates */
+  int width;
+  int height;
+
+  /* size of the widget drawn in the texture, which may be smaller
+   * than the texture itself
+   */
+  int used_width;
+  int used_height;
+
+  /* scale factor of the offscreen window for the texture */
+  int window_scale;
+
+  /* number of texture pixels for each widget unit, and the scale that
+   * was asked for when creating the texture; they differ when binding
+   * the pixmap, which always has the resolution of the window
+   */
+  double scale;
+  double requested_scale;
+
+  /* the scale at which the actor is seen on the stage, rounded to one
+   * of the scale_steps; 0 until the content has been painted
+   */
+  double paint_scale;
+
+  /* areas to upload before the next paint, in widget coordinates */
+  cairo_region_t *damage;
+
+  /* repaint functions uploading the damage before the next paint, and
+   * queueing one after a paint changed the scale of the texture
+   */
+  guint flush_id;
+  guint rescale_id;
+};
+
+struct _GtkClutterWidgetContentClass
+{
+  GObjectClass parent_class;
+};
+
+static void clutter_content_iface_init (ClutterContentIface *iface);
+
+G_DEFINE_TYPE_WITH_CODE (GtkClutterWidgetContent,
+                         _gtk_clutter_widget_content,
+                         G_TYPE_OBJECT,
+                         G_IMPLEMENT_INTERFACE (CLUTTER_TYPE_CONTENT,
+                                                clutter_content_iface_init))
+
+static void
+gtk_clutter_widget_content_set_texture (GtkClutterWidgetContent *self,
+                                        CoglTexture             *texture,
+                                        cairo_surface_t         *surface)
+{
+  if (surface != NULL)
+    cairo_surface_reference (surface);
+
+  /* the texture must go first, as a texture bound to a pixmap needs
+   * to release its Damage object before the pixmap is freed
+   */
+  if (self->texture != NULL)
+    cogl_object_unref (self->texture);
+
+  if (self->surface != NULL)
+    cairo_surface_destroy (self->surface);
+
+  self->texture = texture;
+  self->surface = surface;
+}
+
+#if defined(CLUTTER_WINDOWING_X11) && defined(CAIRO_HAS_XLIB_SURFACE)
+static CoglTexture *
+gtk_clutter_widget_content_create_pixmap_texture (cairo_surface_t *surface)
+{
+  CoglContext *context;
+  CoglTexturePixmapX11 *texture;
+  CoglError *error = NULL;
+
+  context = clutter_backend_get_cogl_context (clutter_get_default_backend ());
+
+  /* with automatic updates Cogl listens to the XDamage events for the
+   * pixmap, and only refreshes the texture when it has changed
+   */
+  texture = cogl_texture_pixmap_x11_new (context,
+                                         cairo_xlib_surface_get_drawable (surface),
+                                         TRUE,
+                                         &error);
+  if (texture == NULL)
+    {
+      g_warning ("Unable to bind the offscreen pixmap, falling back "
+                 "to copying its contents: %s",
+                 error->message);
+      cogl_error_free (error);
+      return NULL;
+    }
+
+  return COGL_TEXTURE (texture);
+}
+#endif
+
+static CoglTexture *
+gtk_clutter_widget_content_create_atlas_texture (int width,
+                                                 int height)
+{
+  CoglContext *context;
+  CoglAtlasTexture *texture;
+  CoglError *error = NULL;
+
+  context = clutter_backend_get_cogl_context (clutter_get_default_backend ());
+
+  texture = cogl_atlas_texture_new_with_size (context, width, height);
+
+  /* the atlas may not be available, e.g. if the driver does not have
+   * the features it needs; we just use a texture of our own then
+   */
+  if (!cogl_texture_allocate (COGL_TEXTURE (texture), &error))
+    {
+      cogl_error_free (error);
+      cogl_object_unref (texture);
+      return NULL;
+    }
+
+  return COGL_TEXTURE (texture);
+}
+
+static void
+gtk_clutter_widget_content_damage_all (GtkClutterWidgetContent *self)
+{
+  cairo_rectangle_int_t full;
+
+  /* this gets clipped to the size of the texture when flushing */
+  full.x = full.y = 0;
+  full.width = G_MAXINT / 2;
+  full.height = G_MAXINT / 2;
+
+  cairo_region_union_rectangle (self->damage, &full);
+}
+
+static gboolean
+gtk_clutter_widget_content_ensure_texture (GtkClutterWidgetContent *self)
+{
+  GdkWindow *window = gtk_widget_get_window (GTK_WIDGET (self->offscreen));
+  cairo_rectangle_int_t area;
+  CoglTexture *texture = NULL;
+  gboolean in_atlas;
+  int width, height, window_scale;
+  int tex_width, tex_height;
+  double scale;
+
+  width = gdk_window_get_width (window);
+  height = gdk_window_get_height (window);
+  window_scale = gdk_window_get_scale_factor (window);
+  scale = self->paint_scale > 0 ? self->paint_scale : window_scale;
+
+  /* the offscreen window gets a new surface when it is realized again,
+   * even at the same size, and the texture must follow its pixmap
+   */
+  if (self->texture != NULL &&
+      !self->needs_new_texture &&
+      (self->surface == NULL ||
+       self->surface == _gtk_clutter_offscreen_get_surface (self->offscreen)) &&
+      self->width == width &&
+      self->height == height &&
+      self->window_scale == window_scale &&
+      self->requested_scale == scale)
+    return TRUE;
+
+  if (width <= 0 || height <= 0)
+    return FALSE;
+
+  self->needs_new_texture = FALSE;
+
+  tex_width = ceil (width * scale);
+  tex_height = ceil (height * scale);
+
+  /* batching small widgets matters more than avoiding the copy, so
+   * the atlas wins over binding the pixmap
+   */
+  in_atlas = self->use_atlas &&
+             tex_width <= ATLAS_MAX_SIZE &&
+             tex_height <= ATLAS_MAX_SIZE;
+
+#if defined(CLUTTER_WINDOWING_X11) && defined(CAIRO_HAS_XLIB_SURFACE)
+  /* the pixmap cannot give us more pixels than the window has */
+  if (self->use_pixmap && !in_atlas && scale <= window_scale)
+    {
+      cairo_surface_t *surface;
+
+      surface = _gtk_clutter_offscreen_get_surface (self->offscreen);
+      if (cairo_surface_get_type (surface) == CAIRO_SURFACE_TYPE_XLIB)
+        {
+          texture = gtk_clutter_widget_content_create_pixmap_texture (surface);
+          if (texture != NULL)
+            {
+              gtk_clutter_widget_content_set_texture (self, texture, surface);
+              self->width = width;
+              self->height = height;
+              self->window_scale = window_scale;
+              self->scale = window_scale;
+              self->requested_scale = scale;
+
+              return TRUE;
+            }
+        }
+
+      /* don't try again for every new surface */
+      self->use_pixmap = FALSE;
+    }
+#endif
+
+  if (in_atlas)
+    texture = gtk_clutter_widget_content_create_atlas_texture (tex_width, tex_height);
+
+  if (texture == NULL)
+    {
+      G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+      texture = cogl_texture_new_with_size (tex_width, tex_height,
+                                            COGL_TEXTURE_NO_ATLAS,
+                                            CLUTTER_CAIRO_FORMAT_ARGB32);
+      G_GNUC_END_IGNORE_DEPRECATIONS
+    }
+
+  /* if we cannot get a new texture we keep painting the old one */
+  if (texture == NULL)
+    return FALSE;
+
+  gtk_clutter_widget_content_set_texture (self, texture, NULL);
+  self->width = width;
+  self->height = height;
+  self->window_scale = window_scale;
+  self->scale = scale;
+  self->requested_scale = scale;
+
+  /* a new texture has undefined contents, so we need to fill all of it */
+  area.x = area.y = 0;
+  area.width = width;
+  area.height = height;
+  cairo_region_union_rectangle (self->damage, &area);
+
+  return TRUE;
+}
+
+/* computes the area of the texture covering @area */
+static gboolean
+gtk_clutter_widget_content_get_texture_area (GtkClutterWidgetContent     *self,
+                                             const cairo_rectangle_int_t *area,
+                                             cairo_rectangle_int_t       *tex_area)
+{
+  int x1, y1, x2, y2;
+
+  x1 = MAX (floor (area->x * self->scale), 0);
+  y1 = MAX (floor (area->y * self->scale), 0);
+  x2 = MIN (ceil ((area->x + area->width) * self->scale),
+            cogl_texture_get_width (self->texture));
+  y2 = MIN (ceil ((area->y + area->height) * self->scale),
+            cogl_texture_get_height (self->texture));
+
+  tex_area->x = x1;
+  tex_area->y = y1;
+  tex_area->width = x2 - x1;
+  tex_area->height = y2 - y1;
+
+  return tex_area->width > 0 && tex_area->height > 0;
+}
+
+/* uploads @area straight out of the pixel data of @surface; this is the
+ * only copy of the pixels between GTK+ and the GPU
+ */
+static void
+gtk_clutter_widget_content_upload_direct (GtkClutterWidgetContent     *self,
+                                          cairo_surface_t             *surface,
+                                          const cairo_rectangle_int_t *area)
+{
+  int scale = self->window_scale;
+  int x = area->x * scale;
+  int y = area->y * scale;
+  int width = area->width * scale;
+  int height = area->height * scale;
+  const guint8 *data;
+  int stride;
+
+  width = MIN (width, cairo_image_surface_get_width (surface) - x);
+  height = MIN (height, cairo_image_surface_get_height (surface) - y);
+  if (width <= 0 || height <= 0)
+    return;
+
+  /* make sure that any pending drawing has reached the pixel data */
+  cairo_surface_flush (surface);
+
+  stride = cairo_image_surface_get_stride (surface);
+  data = cairo_image_surface_get_data (surface) + (y * stride) + (x * 4);
+
+  cogl_texture_set_region (self->texture,
+                           0, 0,
+                           x, y,
+                           width, height,
+                           width, height,
+                           CLUTTER_CAIRO_FORMAT_ARGB32,
+                           stride,
+                           data);
+}
+
+static void
+gtk_clutter_widget_content_upload_image (GtkClutterWidgetContent     *self,
+                                         cairo_surface_t             *image,
+                                         const cairo_rectangle_int_t *tex_area)
+{
+  cairo_surface_flush (image);
+
+  cogl_texture_set_region (self->texture,
+                           0, 0,
+                           tex_area->x, tex_area->y,
+                           tex_area->width, tex_area->height,
+                           tex_area->width, tex_area->height,
+                           CLUTTER_CAIRO_FORMAT_ARGB32,
+                           cairo_image_surface_get_stride (image),
+                           cairo_image_surface_get_data (image));
+}
+
+/* for surfaces we cannot read directly, e.g. an Xlib surface when using
+ * the image surface fallback on X11, or when the texture does not have
+ * the same resolution as the surface, we need to copy the damaged area
+ * in a temporary image surface first
+ */
+static void
+gtk_clutter_widget_content_upload_copy (GtkClutterWidgetContent     *self,
+                                        cairo_surface_t             *surface,
+                                        const cairo_rectangle_int_t *area)
+{
+  cairo_rectangle_int_t tex_area;
+  cairo_surface_t *image;
+  cairo_t *cr;
+
+  if (!gtk_clutter_widget_content_get_texture_area (self, area, &tex_area))
+    return;
+
+  image = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
+                                      tex_area.width,
+                                      tex_area.height);
+
+  cr = cairo_create (image);
+  cairo_translate (cr, -tex_area.x, -tex_area.y);
+  cairo_scale (cr, self->scale, self->scale);
+  cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+  cairo_set_source_surface (cr, surface, 0, 0);
+  cairo_paint (cr);
+  cairo_destroy (cr);
+
+  gtk_clutter_widget_content_upload_image (self, image, &tex_area);
+
+  cairo_surface_destroy (image);
+}
+
+/* when the actor is zoomed in, the offscreen surface does not have
+ * enough pixels for the texture, so we draw the damaged area of the
+ * widget again, at the resolution of the texture
+ */
+static void
+gtk_clutter_widget_content_upload_draw (GtkClutterWidgetContent     *self,
+                                        const cairo_rectangle_int_t *area)
+{
+  GtkWidget *widget = GTK_WIDGET (self->offscreen);
+  cairo_rectangle_int_t tex_area;
+  cairo_surface_t *image;
+  cairo_t *cr;
+
+  if (!gtk_clutter_widget_content_get_texture_area (self, area, &tex_area))
+    return;
+
+  image = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
+                                      tex_area.width,
+                                      tex_area.height);
+
+  cr = cairo_create (image);
+  cairo_translate (cr, -tex_area.x, -tex_area.y);
+  cairo_scale (cr, self->scale, self->scale);
+  gdk_cairo_rectangle (cr, area);
+  cairo_clip (cr);
+
+  /* the background is drawn by GDK on the offscreen window, not by
+   * the widget itself
+   */
+  gtk_render_background (gtk_widget_get_style_context (widget), cr,
+                         0, 0,
+                         self->width, self->height);
+  gtk_widget_draw (widget, cr);
+  cairo_destroy (cr);
+
+  gtk_clutter_widget_content_upload_image (self, image, &tex_area);
+
+  cairo_surface_destroy (image);
+}
+
+static void
+gtk_clutter_widget_content_upload (GtkClutterWidgetContent     *self,
+                                   cairo_surface_t             *surface,
+                                   const cairo_rectangle_int_t *area)
+{
+  /* GDK creates the offscreen surface with CAIRO_CONTENT_COLOR_ALPHA,
+   * and its premultiplied ARGB32 layout is what CLUTTER_CAIRO_FORMAT_ARGB32
+   * describes, so we can use the pixels as they are
+   */
+  if (self->scale > self->window_scale)
+    gtk_clutter_widget_content_upload_draw (self, area);
+  else if (self->scale == self->window_scale &&
+           cairo_surface_get_type (surface) == CAIRO_SURFACE_TYPE_IMAGE &&
+           cairo_image_surface_get_format (surface) == CAIRO_FORMAT_ARGB32)
+    gtk_clutter_widget_content_upload_direct (self, surface, area);
+  else
+    gtk_clutter_widget_content_upload_copy (self, surface, area);
+}
+
+static void
+gtk_clutter_widget_content_flush (GtkClutterWidgetContent *self)
+{
+  cairo_rectangle_int_t bounds, area;
+  cairo_surface_t *surface;
+  int i, n_rects;
+
+  if (!gtk_widget_get_realized (GTK_WIDGET (self->offscreen)))
+    return;
+
+  /* after a resize, the offscreen window has a new surface which GTK+
+   * may not have drawn yet; we keep showing the current texture, scaled
+   * to the new size, until the widget has been painted and damaged, and
+   * only then replace it with a texture of the right size
+   */
+  if (cairo_region_is_empty (self->damage))
+    return;
+
+  if (!gtk_clutter_widget_content_ensure_texture (self))
+    return;
+
+  self->used_width = MIN (gtk_widget_get_allocated_width (GTK_WIDGET (self->offscreen)),
+                          self->width);
+  self->used_height = MIN (gtk_widget_get_allocated_height (GTK_WIDGET (self->offscreen)),
+                           self->height);
+
+  /* a texture bound to the pixmap is kept up to date by Cogl */
+  if (self->surface != NULL)
+    {
+      cairo_region_destroy (self->damage);
+      self->damage = cairo_region_create ();
+      return;
+    }
+
+  /* the rest of the window is never painted */
+  bounds.x = bounds.y = 0;
+  bounds.width = self->used_width;
+  bounds.height = self->used_height;
+  cairo_region_intersect_rectangle (self->damage, &bounds);
+
+  if (cairo_region_is_empty (self->damage))
+    return;
+
+  surface = _gtk_clutter_offscreen_get_surface (self->offscreen);
+
+  n_rects = cairo_region_num_rectangles (self->damage);
+  if (n_rects > MAX_DAMAGE_RECTS)
+    {
+      cairo_region_get_extents (self->damage, &area);
+      gtk_clutter_widget_content_upload (self, surface, &area);
+    }
+  else
+    {
+      for (i = 0; i < n_rects; i++)
+        {
+          cairo_region_get_rectangle (self->damage, i, &area);
+          gtk_clutter_widget_content_upload (self, surface, &area);
+        }
+    }
+
+  cairo_region_destroy (self->damage);
+  self->damage = cairo_region_create ();
+}
+
+static gboolean
+gtk_clutter_widget_content_flush_func (gpointer user_data)
+{
+  GtkClutterWidgetContent *self = user_data;
+
+  self->flush_id = 0;
+
+  gtk_clutter_widget_content_flush (self);
+
+  return G_SOURCE_REMOVE;
+}
+
+static gboolean
+gtk_clutter_widget_content_rescale (gpointer user_data)
+{
+  GtkClutterWidgetContent *self = user_data;
+
+  self->rescale_id = 0;
+
+  /* the scale was changed by a paint; queue a flush and a redraw */
+  _gtk_clutter_widget_content_damage (self, NULL);
+
+  return G_SOURCE_REMOVE;
+}
+
+static double
+gtk_clutter_widget_content_quantize_scale (double current,
+                                           double desired)
+{
+  guint i;
+
+  /* we keep the current step as long as the actor is not seen clearly
+   * larger or smaller than it; this avoids throwing away the texture on
+   * every frame of an animation
+   */
+  if (current > 0 &&
+      desired <= current * (1.0 + SCALE_HYSTERESIS) &&
+      desired >= current * (1.0 - SCALE_HYSTERESIS))
+    return current;
+
+  for (i = 0; i < G_N_ELEMENTS (scale_steps); i++)
+    {
+      if (scale_steps[i] >= desired)
+        return scale_steps[i];
+    }
+
+  return scale_steps[G_N_ELEMENTS (scale_steps) - 1];
+}
+
+static void
+gtk_clutter_widget_content_update_paint_scale (GtkClutterWidgetContent *self,
+                                               ClutterActor            *actor)
+{
+  GdkWindow *window = gtk_widget_get_window (GTK_WIDGET (self->offscreen));
+  gfloat width, height, transformed_width, transformed_height;
+  double desired, scale;
+
+  clutter_actor_get_size (actor, &width, &height);
+  if (width <= 0 || height <= 0)
+    return;
+
+  clutter_actor_get_transformed_size (actor,
+                                      &transformed_width,
+                                      &transformed_height);
+
+  /* the stage has the same scale factor as the window embedding it */
+  desired = MAX (transformed_width / width, transformed_height / height)
+          * gdk_window_get_scale_factor (window);
+
+  scale = gtk_clutter_widget_content_quantize_scale (self->paint_scale, desired);
+  if (scale == self->paint_scale)
+    return;
+
+  self->paint_scale = scale;
+
+  /* the texture is filled again at the new resolution before the next
+   * paint; drawing the widget from here would stall the paint
+   */
+  if (self->texture != NULL && scale != self->requested_scale &&
+      self->rescale_id == 0)
+    self->rescale_id =
+      clutter_threads_add_repaint_func_full (CLUTTER_REPAINT_FLAGS_POST_PAINT,
+                                             gtk_clutter_widget_content_rescale,
+                                             self,
+                                             NULL);
+}
+
+static void
+gtk_clutter_widget_content_paint_content (ClutterContent   *content,
+                                          ClutterActor     *actor,
+                                          ClutterPaintNode *root)
+{
+  GtkClutterWidgetContent *self = GTK_CLUTTER_WIDGET_CONTENT (content);
+  ClutterScalingFilter min_f, mag_f;
+  ClutterPaintNode *node;
+  ClutterActorBox box;
+  ClutterColor color;
+  guint8 paint_opacity;
+
+  if (!self->frozen &&
+      gtk_widget_get_realized (GTK_WIDGET (self->offscreen)))
+    gtk_clutter_widget_content_update_paint_scale (self, actor);
+
+  if (self->texture == NULL)
+    return;
+
+  clutter_actor_get_content_box (actor, &box);
+  clutter_actor_get_content_scaling_filters (actor, &min_f, &mag_f);
+  paint_opacity = clutter_actor_get_paint_opacity (actor);
+
+  color.red = paint_opacity;
+  color.green = paint_opacity;
+  color.blue = paint_opacity;
+  color.alpha = paint_opacity;
+
+  node = clutter_texture_node_new (self->texture, &color, min_f, mag_f);
+  clutter_paint_node_set_name (node, "Widget Content");
+  clutter_paint_node_add_texture_rectangle (node, &box,
+                                            0.0, 0.0,
+                                            self->used_width * self->scale
+                                            / cogl_texture_get_width (self->texture),
+                                            self->used_height * self->scale
+                                            / cogl_texture_get_height (self->texture));
+  clutter_paint_node_add_child (root, node);
+  clutter_paint_node_unref (node);
+}
+
+static gboolean
+gtk_clutter_widget_content_get_preferred_size (ClutterContent *content,
+                                               gfloat         *width,
+                                               gfloat         *height)
+{
+  GtkClutterWidgetContent *self = GTK_CLUTTER_WIDGET_CONTENT (content);
+
+  if (self->texture == NULL)
+    return FALSE;
+
+  if (width != NULL)
+    *width = self->used_width;
+
+  if (height != NULL)
+    *height = self->used_height;
+
+  return TRUE;
+}
+
+static void
+clutter_content_iface_init (ClutterContentIface *iface)
+{
+  iface->paint_content = gtk_clutter_widget_content_paint_content;
+  iface->get_preferred_size = gtk_clutter_widget_content_get_preferred_size;
+}
+
+static void
+gtk_clutter_widget_content_finalize (GObject *gobject)
+{
+  GtkClutterWidgetContent *self = GTK_CLUTTER_WIDGET_CONTENT (gobject);
+
+  if (self->flush_id != 0)
+    clutter_threads_remove_repaint_func (self->flush_id);
+
+  if (self->rescale_id != 0)
+    clutter_threads_remove_repaint_func (self->rescale_id);
+
+  gtk_clutter_widget_content_set_texture (self, NULL, NULL);
+
+  cairo_region_destroy (self->damage);
+
+  G_OBJECT_CLASS (_gtk_clutter_widget_content_parent_class)->finalize (gobject);
+}
+
+static void
+_gtk_clutter_widget_content_class_init (GtkClutterWidgetContentClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  gobject_class->finalize = gtk_clutter_widget_content_finalize;
+}
+
+static void
+_gtk_clutter_widget_content_init (GtkClutterWidgetContent *self)
+{
+  self->damage = cairo_region_create ();
+  self->window_scale = 1;
+  self->scale = 1.0;
+}
+
+/*
+ * _gtk_clutter_widget_content_new:
+ * @offscreen: the #GtkClutterOffscreen to paint
+ * @use_pixmap: whether to bind the pixmap of the offscreen window as a
+ *   texture when possible, instead of copying its contents
+ *
+ * Creates a new #ClutterContent showing the contents of @offscreen.
+ */
+ClutterContent *
+_gtk_clutter_widget_content_new (GtkClutterOffscreen *offscreen,
+                                 gboolean             use_pixmap)
+{
+  GtkClutterWidgetContent *self;
+
+  self = g_object_new (GTK_CLUTTER_TYPE_WIDGET_CONTENT, NULL);
+  self->offscreen = offscreen; /* Back pointer, actor owns both */
+  self->use_pixmap = use_pixmap != FALSE;
+
+  return CLUTTER_CONTENT (self);
+}
+
+/*
+ * _gtk_clutter_widget_content_damage:
+ * @content: a #GtkClutterWidgetContent
+ * @region: (allow-none): the damaged region, in widget coordinates, or
+ *   %NULL to damage the whole widget
+ *
+ * Marks @region as needing to be uploaded again before the next paint,
+ * and queues a redraw of the actors using @content.
+ */
+void
+_gtk_clutter_widget_content_damage (GtkClutterWidgetContent *content,
+                                    const cairo_region_t    *region)
+{
+  if (region != NULL)
+    cairo_region_union (content->damage, region);
+  else
+    gtk_clutter_widget_content_damage_all (content);
+
+  if (content->flush_id == 0)
+    content->flush_id =
+      clutter_threads_add_repaint_func_full (CLUTTER_REPAINT_FLAGS_PRE_PAINT,
+                                             gtk_clutter_widget_content_flush_func,
+                                             content,
+                                             NULL);
+
+  clutter_content_invalidate (CLUTTER_CONTENT (content));
+}
+
+/*
+ * _gtk_clutter_widget_content_flush:
+ * @content: a #GtkClutterWidgetContent
+ *
+ * Uploads the damaged areas of @content right away. This is meant to
+ * be called from a pre-paint function, since repaint functions added
+ * while they are being run only run on the next frame.
+ */
+void
+_gtk_clutter_widget_content_flush (GtkClutterWidgetContent *content)
+{
+  if (content->flush_id != 0)
+    {
+      clutter_threads_remove_repaint_func (content->flush_id);
+      content->flush_id = 0;
+    }
+
+  gtk_clutter_widget_content_flush (content);
+}
+
+/*
+ * _gtk_clutter_widget_content_set_use_atlas:
+ * @content: a #GtkClutterWidgetContent
+ * @use_atlas: whether to allocate small textures in the shared atlas
+ *
+ * Sets whether the texture of @content should be allocated in the
+ * texture atlas shared by Cogl when it is small enough.
+ */
+void
+_gtk_clutter_widget_content_set_use_atlas (GtkClutterWidgetContent *content,
+                                           gboolean                 use_atlas)
+{
+  use_atlas = use_atlas != FALSE;
+
+  if (content->use_atlas == use_atlas)
+    return;
+
+  content->use_atlas = use_atlas;
+
+  /* the whole texture has to be moved in or out of the atlas */
+  content->needs_new_texture = TRUE;
+  _gtk_clutter_widget_content_damage (content, NULL);
+}
+
+/*
+ * _gtk_clutter_widget_content_set_frozen:
+ * @content: a #GtkClutterWidgetContent
+ * @frozen: whether the contents should be kept as they are
+ *
+ * Sets whether @content keeps the resolution of its texture when the
+ * scale of the actor changes; this is used while the actor is frozen,
+ * or cannot be seen. The resolution catches up on the next paint once
+ * @frozen is %FALSE again.
+ */
+void
+_gtk_clutter_widget_content_set_frozen (GtkClutterWidgetContent *content,
+                                        gboolean                 frozen)
+{
+  frozen = frozen != FALSE;
+
+  if (content->frozen == frozen)
+    return;
+
+  content->frozen = frozen;
+
+  if (!frozen)
+    clutter_content_invalidate (CLUTTER_CONTENT (content));
+}
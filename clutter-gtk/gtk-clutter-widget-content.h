@@ -0,0 +1,48 @@
+/* gtk-clutter-widget-content.h: ClutterContent for embedded widgets
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not see <http://www.fsf.org/licensing>.
+ */
+
+#ifndef __GTK_CLUTTER_WIDGET_CONTENT_H__
+#define __GTK_CLUTTER_WIDGET_CONTENT_H__
+
+#include <cairo/cairo.h>
+#include <gtk/gtk.h>
+#include <clutter/clutter.h>
+
+#include "gtk-clutter-offscreen.h"
+
+G_BEGIN_DECLS
+
+#define GTK_CLUTTER_TYPE_WIDGET_CONTENT         (_gtk_clutter_widget_content_get_type ())
+#define GTK_CLUTTER_WIDGET_CONTENT(obj)         (G_TYPE_CHECK_INSTANCE_CAST ((obj), GTK_CLUTTER_TYPE_WIDGET_CONTENT, GtkClutterWidgetContent))
+#define GTK_CLUTTER_IS_WIDGET_CONTENT(obj)      (G_TYPE_CHECK_INSTANCE_TYPE ((obj), GTK_CLUTTER_TYPE_WIDGET_CONTENT))
+
+typedef struct _GtkClutterWidgetContent         GtkClutterWidgetContent;
+typedef struct _GtkClutterWidgetContentClass    GtkClutterWidgetContentClass;
+
+GType           _gtk_clutter_widget_content_get_type (void) G_GNUC_CONST;
+ClutterContent *_gtk_clutter_widget_content_new      (GtkClutterOffscreen           *offscreen,
+                                                      gboolean                       use_pixmap);
+void            _gtk_clutter_widget_content_damage   (GtkClutterWidgetContent       *content,
+                                                      const cairo_region_t          *region);
+void            _gtk_clutter_widget_content_flush    (GtkClutterWidgetContent       *content);
+void            _gtk_clutter_widget_content_set_use_atlas (GtkClutterWidgetContent  *content,
+                                                           gboolean                  use_atlas);
+void            _gtk_clutter_widget_content_set_frozen    (GtkClutterWidgetContent  *content,
+                                                           gboolean                  frozen);
+
+G_END_DECLS
+
+#endif /* __GTK_CLUTTER_WIDGET_CONTENT_H__ */
@@ -6,9 +6,10 @@
 int
 main (int argc, char *argv[])
 {
-  ClutterActor *stage0, *stage1, *stage2, *tex1, *tex2;
+  ClutterActor *stage0, *stage1, *stage2, *text0, *tex1, *tex2;
   GtkWidget *window, *clutter0, *clutter1, *clutter2;
   GtkWidget *notebook, *vbox;
+  ClutterTransition *spin;
   ClutterColor col0 = { 0xdd, 0xff, 0xdd, 0xff };
   ClutterColor col1 = { 0xff, 0xff, 0xff, 0xff };
   ClutterColor col2 = {    0,    0,    0, 0xff };
@@ -30,11 +31,23 @@ main (int argc, char *argv[])
   stage0 = gtk_clutter_embed_get_stage (GTK_CLUTTER_EMBED (clutter0));
   clutter_actor_set_background_color (stage0, &col0);
 
+  /* the stage is stretched while the window is being resized, and laid
+   * out again once the resize is over
+   */
+  gtk_clutter_embed_set_live_resize (GTK_CLUTTER_EMBED (clutter0), TRUE);
+  text0 = clutter_text_new_with_text (NULL, "Resize the window");
+  clutter_actor_add_constraint (text0, clutter_align_constraint_new (stage0, CLUTTER_ALIGN_BOTH, .5));
+  clutter_actor_add_child (stage0, text0);
+
   vbox = gtk_box_new (GTK_ORIENTATION_VERTICAL, 6);
   gtk_notebook_append_page (GTK_NOTEBOOK (notebook), vbox,
                             gtk_label_new ("Two stages"));
 
+  /* switching pages unmaps the embeds; keep their stages around for a
+   * while, so that switching back does not have to create them again
+   */
   clutter1 = gtk_clutter_embed_new ();
+  gtk_clutter_embed_set_keep_warm_timeout (GTK_CLUTTER_EMBED (clutter1), 5000);
   gtk_widget_set_size_request (clutter1, 320, 240);
   stage1 = gtk_clutter_embed_get_stage (GTK_CLUTTER_EMBED (clutter1));
   clutter_actor_set_background_color (stage1, &col1);
@@ -50,9 +63,23 @@ main (int argc, char *argv[])
   clutter_actor_add_child (stage1, tex1); 
   clutter_actor_show (tex1);
 
+  /* transitions named after the property they animate are paused while
+   * the page is not shown, and resume where they were
+   */
+  gtk_clutter_embed_set_pause_timelines (GTK_CLUTTER_EMBED (clutter1), TRUE);
+  clutter_actor_set_pivot_point (tex1, .5, .5);
+  spin = clutter_property_transition_new ("rotation-angle-z");
+  clutter_transition_set_from (spin, G_TYPE_DOUBLE, 0.0);
+  clutter_transition_set_to (spin, G_TYPE_DOUBLE, 360.0);
+  clutter_timeline_set_duration (CLUTTER_TIMELINE (spin), 3000);
+  clutter_timeline_set_repeat_count (CLUTTER_TIMELINE (spin), -1);
+  clutter_actor_add_transition (tex1, "rotation-angle-z", spin);
+  g_object_unref (spin);
+
   gtk_container_add (GTK_CONTAINER (vbox), clutter1);
 
   clutter2 = gtk_clutter_embed_new ();
+  gtk_clutter_embed_set_keep_warm_timeout (GTK_CLUTTER_EMBED (clutter2), 5000);
   gtk_widget_set_size_request (clutter2, 320, 120);
   stage2 = gtk_clutter_embed_get_stage (GTK_CLUTTER_EMBED (clutter2));
   clutter_actor_set_background_color (stage2, &col2);
@@ -15,6 +15,24 @@ static gboolean do_rotate = TRUE;
 
 static int nwidgets;
 
+static gboolean use_atlas = FALSE;
+static gboolean frozen = FALSE;
+static gint max_update_rate = 0;
+static gboolean scale_during_resize = FALSE;
+static gint resize_interval = 0;
+
+static GOptionEntry entries[] = {
+  { "use-atlas", 'a', 0, G_OPTION_ARG_NONE, &use_atlas,
+    "Allocate the textures of the widgets in the texture atlas", NULL },
+  { "max-update-rate", 'r', 0, G_OPTION_ARG_INT, &max_update_rate,
+    "Update the widgets at most RATE times per second", "RATE" },
+  { "scale-during-resize", 's', 0, G_OPTION_ARG_NONE, &scale_during_resize,
+    "Scale the widgets while their size is animated", NULL },
+  { "resize-interval", 'i', 0, G_OPTION_ARG_INT, &resize_interval,
+    "Lay out the widgets every MSEC milliseconds while scaled", "MSEC" },
+  { NULL }
+};
+
 /* Timeline handler */
 void
 frame_cb (ClutterTimeline *timeline,
@@ -48,15 +66,54 @@ button_clicked (GtkWidget *button,
   gtk_box_pack_start (GTK_BOX (vbox), label, FALSE, FALSE, 0);
 }
 
+static void
+freeze_toggled (GtkToggleButton *button,
+                gpointer         user_data)
+{
+  gint i;
+
+  /* the widgets keep showing what they had drawn until thawed */
+  frozen = gtk_toggle_button_get_active (button);
+
+  for (i = 0; i < nwidgets; i++)
+    gtk_clutter_actor_set_frozen (GTK_CLUTTER_ACTOR (widgets[i]), frozen);
+}
+
+static void
+grow_toggled (GtkToggleButton *button,
+              ClutterActor    *actor)
+{
+  gfloat width;
+
+  clutter_actor_get_preferred_width (actor, -1, NULL, &width);
+  if (gtk_toggle_button_get_active (button))
+    width *= 1.5;
+
+  clutter_actor_save_easing_state (actor);
+  clutter_actor_set_easing_duration (actor, 1000);
+  clutter_actor_set_width (actor, width);
+  clutter_actor_restore_easing_state (actor);
+}
+
 static ClutterActor *
 create_gtk_actor (int i)
 {
-  GtkWidget       *button, *vbox, *entry, *bin;
+  GtkWidget       *button, *vbox, *entry, *spinner, *bin;
   ClutterActor    *gtk_actor;
 
   gtk_actor = gtk_clutter_actor_new ();
   bin = gtk_clutter_actor_get_widget (GTK_CLUTTER_ACTOR (gtk_actor));
 
+  /* the widgets are small, so they can share a texture */
+  gtk_clutter_actor_set_use_atlas (GTK_CLUTTER_ACTOR (gtk_actor), use_atlas);
+  gtk_clutter_actor_set_frozen (GTK_CLUTTER_ACTOR (gtk_actor), frozen);
+  gtk_clutter_actor_set_max_update_rate (GTK_CLUTTER_ACTOR (gtk_actor),
+                                         MAX (max_update_rate, 0));
+  gtk_clutter_actor_set_scale_during_resize (GTK_CLUTTER_ACTOR (gtk_actor),
+                                             scale_during_resize);
+  gtk_clutter_actor_set_resize_interval (GTK_CLUTTER_ACTOR (gtk_actor),
+                                         MAX (resize_interval, 0));
+
   vbox = gtk_box_new (GTK_ORIENTATION_VERTICAL, 6);
   gtk_container_add (GTK_CONTAINER (bin), vbox);
 
@@ -65,12 +122,19 @@ create_gtk_actor (int i)
 
   g_signal_connect (button, "clicked", G_CALLBACK (button_clicked), vbox);
 
-  button = gtk_check_button_new_with_label ("Another button");
+  button = gtk_check_button_new_with_label ("Grow");
   gtk_box_pack_start (GTK_BOX (vbox), button, FALSE, FALSE, 0);
 
+  g_signal_connect (button, "toggled", G_CALLBACK (grow_toggled), gtk_actor);
+
   entry = gtk_entry_new ();
   gtk_box_pack_start (GTK_BOX (vbox), entry, FALSE, FALSE, 0);
 
+  /* keeps the widget changing all the time */
+  spinner = gtk_spinner_new ();
+  gtk_spinner_start (GTK_SPINNER (spinner));
+  gtk_box_pack_start (GTK_BOX (vbox), spinner, FALSE, FALSE, 0);
+
   gtk_widget_show_all (bin);
 
   return gtk_actor;
@@ -130,7 +194,7 @@ main (int argc, char *argv[])
   GtkWidget       *button, *vbox;
   gint             i;
 
-  if (gtk_clutter_init_with_args (&argc, &argv, NULL, NULL, NULL, NULL) != CLUTTER_INIT_SUCCESS)
+  if (gtk_clutter_init_with_args (&argc, &argv, NULL, entries, NULL, NULL) != CLUTTER_INIT_SUCCESS)
     g_error ("Unable to initialize GtkClutter");
 
   if (argc != 1)
@@ -155,6 +219,12 @@ main (int argc, char *argv[])
 			    window);
   gtk_box_pack_end (GTK_BOX (vbox), button, FALSE, FALSE, 0);
 
+  button = gtk_toggle_button_new_with_mnemonic ("_Freeze widgets");
+  g_signal_connect (button, "toggled",
+                    G_CALLBACK (freeze_toggled),
+                    NULL);
+  gtk_box_pack_end (GTK_BOX (vbox), button, FALSE, FALSE, 0);
+
   clutter_actor_set_background_color (stage, &stage_color);
 
   nwidgets = 0;